@@ -0,0 +1,84 @@
+#include <glad/glad.h>
+#include <cmath>
+#include <string>
+#include "accumulation.h"
+#include "shader_read.h"
+
+bool createAccumulation(Accumulation& acc, const char* vertexSource, const char* fragmentSource)
+{
+    std::string fragment = injectShaderDefines(fragmentSource, "#define ACCUMULATE_RESOLVE\n");
+    acc.resolve = createBlackholeProgram(vertexSource, fragment.c_str());
+    return acc.resolve.program != 0;
+}
+
+void deleteAccumulation(Accumulation& acc)
+{
+    if (acc.sum.fbo != 0)
+        deleteRenderTarget(acc.sum);
+    deleteBlackholeProgram(acc.resolve);
+    acc = Accumulation();
+}
+
+void accumulationJitter(const Accumulation& acc, float& x, float& y)
+{
+    // R2 Уƽ 1.3247...ǰ׺ڶֲȣҪԤ֪
+    const double a1 = 0.7548776662466927;
+    const double a2 = 0.5698402909980532;
+    double n = static_cast<double>(acc.samples);
+    x = static_cast<float>(std::fmod(0.5 + a1 * n, 1.0)) - 0.5f;
+    y = static_cast<float>(std::fmod(0.5 + a2 * n, 1.0)) - 0.5f;
+}
+
+bool beginAccumulation(Accumulation& acc, int width, int height, float time, float mouseX, float mouseY)
+{
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &acc.outputFbo);
+    glGetIntegerv(GL_VIEWPORT, acc.outputViewport);
+
+    if (acc.sum.width != width || acc.sum.height != height)
+    {
+        if (acc.sum.fbo != 0)
+            deleteRenderTarget(acc.sum);
+        // 32 λ㣺ǧʱ뾫Ȼᶪλ
+        if (!createRenderTarget(acc.sum, width, height, GL_RGBA32F))
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, acc.outputFbo);
+            return false;
+        }
+        acc.samples = 0;
+    }
+    if (time != acc.time || mouseX != acc.mouseX || mouseY != acc.mouseY)
+        acc.samples = 0;
+    acc.time = time;
+    acc.mouseX = mouseX;
+    acc.mouseY = mouseY;
+
+    bindRenderTarget(acc.sum);
+    if (acc.samples == 0)
+    {
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    return true;
+}
+
+void resetAccumulation(Accumulation& acc)
+{
+    acc.samples = 0;
+}
+
+void resolveAccumulation(Accumulation& acc, const FullscreenQuad& quad)
+{
+    glDisable(GL_BLEND);
+    acc.samples++;
+
+    const int* viewport = acc.outputViewport;
+    glBindFramebuffer(GL_FRAMEBUFFER, acc.outputFbo);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glUseProgram(acc.resolve.program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, acc.sum.colorTex);
+    glUniform1i(glGetUniformLocation(acc.resolve.program, "iAccumulation"), 0);
+    drawFullscreenQuad(quad);
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "blackhole_pass.h"
+#include "fullscreen_quad.h"
+#include "render_target.h"
+
+// ۻ--stillÿλ׷һضĹߣAA ǿΪ 1ȡ R2 ͲУ
+// ɫӷϵ RGBA32F ۻ壨a Ϊٰƽֵ٤Уߵ֡塣
+// ÿλ֮ĶǵǰĻ棻ֱʡiTime  iMouse ıʱ¿ʼۻ
+struct Accumulation
+{
+    RenderTarget sum;           // rgb Ϊɫ֮ͣa Ϊ
+    BlackholeProgram resolve;
+    long long samples = 0;      // ۻ
+
+    // ۻ
+    float time = 0.0f;
+    float mouseX = 0.0f;
+    float mouseY = 0.0f;
+
+    // ߵ֡ӿڣʱ
+    int outputFbo = 0;
+    int outputViewport[4] = {};
+};
+
+bool createAccumulation(Accumulation& acc, const char* vertexSource, const char* fragmentSource);
+void deleteAccumulation(Accumulation& acc);
+
+// һضأΧ -0.5 ~ 0.5
+void accumulationJitter(const Accumulation& acc, float& x, float& y);
+
+// µߵ֡ӿڣۻ岢ӷϣߴıʱգʱӿΪ width x height
+bool beginAccumulation(Accumulation& acc, int width, int height, float time, float mouseX, float mouseY);
+// رջϣƽֵߵ֡岢ָӿ
+void resolveAccumulation(Accumulation& acc, const FullscreenQuad& quad);
+// һ beginAccumulation ۻ壨ıʱɵߵãлֿ飩
+void resetAccumulation(Accumulation& acc);
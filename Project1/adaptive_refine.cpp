@@ -0,0 +1,188 @@
+#include <glad/glad.h>
+#include <iostream>
+#include <string>
+#include "adaptive_refine.h"
+#include "shader_read.h"
+
+// ݷڲֵƵǿգ 32 λ
+static const GLenum CoarseFormats[2] = { GL_RGBA16F, GL_RGBA32F };
+
+static void deleteTargets(AdaptiveRefine& refine)
+{
+    glDeleteFramebuffers(1, &refine.coarseFbo);
+    glDeleteTextures(2, refine.coarseTextures);
+    refine.coarseFbo = 0;
+    refine.coarseTextures[0] = refine.coarseTextures[1] = 0;
+    refine.coarseWidth = 0;
+    refine.coarseHeight = 0;
+    if (refine.target.fbo != 0)
+        deleteRenderTarget(refine.target);
+}
+
+static bool createTargets(AdaptiveRefine& refine, int width, int height)
+{
+    // ֲÿһأĶӦģ pass Թ˲ֵ
+    refine.coarseWidth = (width + refine.blockSize - 1) / refine.blockSize;
+    refine.coarseHeight = (height + refine.blockSize - 1) / refine.blockSize;
+    glGenTextures(2, refine.coarseTextures);
+    glGenFramebuffers(1, &refine.coarseFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, refine.coarseFbo);
+    GLenum drawBuffers[2];
+    for (int i = 0; i < 2; i++)
+    {
+        glBindTexture(GL_TEXTURE_2D, refine.coarseTextures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, CoarseFormats[i], refine.coarseWidth, refine.coarseHeight, 0, GL_RGBA, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, refine.coarseTextures[i], 0);
+        drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+    }
+    glDrawBuffers(2, drawBuffers);
+    // 
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "Ӧϸֲ֡岻" << std::endl;
+        deleteTargets(refine);
+        return false;
+    }
+
+    if (!createRenderTarget(refine.target, width, height, GL_RGBA8) || !attachDepthStencil(refine.target))
+    {
+        deleteTargets(refine);
+        return false;
+    }
+    return true;
+}
+
+bool createAdaptiveRefine(AdaptiveRefine& refine, int blockSize, float threshold,
+    const char* vertexSource, const char* fragmentSource)
+{
+    refine.blockSize = blockSize;
+    refine.threshold = threshold;
+    std::string fragment = injectShaderDefines(fragmentSource, "#define ADAPTIVE_CLASSIFY\n");
+    refine.classify = createBlackholeProgram(vertexSource, fragment.c_str());
+    if (refine.classify.program == 0)
+        return false;
+    glGenQueries(AdaptiveQueryCount, refine.queries);
+    return true;
+}
+
+void deleteAdaptiveRefine(AdaptiveRefine& refine)
+{
+    deleteTargets(refine);
+    for (int i = 0; i < ShaderQualityCount; i++)
+        deleteBlackholeProgram(refine.coarse[i]);
+    deleteBlackholeProgram(refine.classify);
+    glDeleteQueries(AdaptiveQueryCount, refine.queries);
+    refine = AdaptiveRefine();
+}
+
+bool beginAdaptiveRefine(AdaptiveRefine& refine, ShaderQuality quality, int width, int height,
+    float time, float mouseX, float mouseY)
+{
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &refine.outputFbo);
+    glGetIntegerv(GL_VIEWPORT, refine.outputViewport);
+
+    if (refine.target.width != width || refine.target.height != height)
+    {
+        deleteTargets(refine);
+        if (!createTargets(refine, width, height))
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, refine.outputFbo);
+            return false;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, refine.coarseFbo);
+    glViewport(0, 0, refine.coarseWidth, refine.coarseHeight);
+    // iResolution ȫֱʣɫ gl_FragCoord * iBlockSize 
+    const BlackholeProgram& coarse = refine.coarse[static_cast<int>(quality)];
+    useBlackholeProgram(coarse, time, static_cast<float>(width), static_cast<float>(height), mouseX, mouseY);
+    glUniform1i(glGetUniformLocation(coarse.program, "iBlockSize"), refine.blockSize);
+    return true;
+}
+
+void beginAdaptiveClassify(AdaptiveRefine& refine, float time, float mouseX, float mouseY, int firstUnit)
+{
+    bindRenderTarget(refine.target);
+    glClearStencil(1);
+    glClear(GL_STENCIL_BUFFER_BIT);
+    //  pass ҪϸأͨԺģ 0
+    glEnable(GL_STENCIL_TEST);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+
+    unsigned int program = refine.classify.program;
+    useBlackholeProgram(refine.classify, time, static_cast<float>(refine.target.width),
+        static_cast<float>(refine.target.height), mouseX, mouseY);
+    for (int i = 0; i < 2; i++)
+    {
+        glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+        glBindTexture(GL_TEXTURE_2D, refine.coarseTextures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(glGetUniformLocation(program, "iCoarseColor"), firstUnit);
+    glUniform1i(glGetUniformLocation(program, "iCoarseEscape"), firstUnit + 1);
+    glUniform1i(glGetUniformLocation(program, "iBlockSize"), refine.blockSize);
+    glUniform1f(glGetUniformLocation(program, "iThreshold"), refine.threshold);
+}
+
+void beginAdaptiveTrace(AdaptiveRefine& refine)
+{
+    glStencilFunc(GL_EQUAL, 1, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+
+    // GPU 󳬹 AdaptiveQueryCount ֡ʱһ֡
+    pollAdaptiveRefine(refine);
+    int index = refine.nextQuery;
+    refine.queryActive = !refine.queryPending[index];
+    if (refine.queryActive)
+    {
+        glBeginQuery(GL_SAMPLES_PASSED, refine.queries[index]);
+        refine.queryPixels[index] = static_cast<long long>(refine.target.width) * refine.target.height;
+        refine.queryCoarsePixels[index] = static_cast<long long>(refine.coarseWidth) * refine.coarseHeight;
+    }
+}
+
+void endAdaptiveRefine(AdaptiveRefine& refine)
+{
+    if (refine.queryActive)
+    {
+        glEndQuery(GL_SAMPLES_PASSED);
+        refine.queryPending[refine.nextQuery] = true;
+        refine.nextQuery = (refine.nextQuery + 1) % AdaptiveQueryCount;
+        refine.queryActive = false;
+    }
+    glDisable(GL_STENCIL_TEST);
+
+    const int* viewport = refine.outputViewport;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, refine.target.fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, refine.outputFbo);
+    glBlitFramebuffer(0, 0, refine.target.width, refine.target.height, viewport[0], viewport[1],
+        viewport[0] + viewport[2], viewport[1] + viewport[3], GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, refine.outputFbo);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void pollAdaptiveRefine(AdaptiveRefine& refine)
+{
+    // ˳أδɵĲѯͣ
+    for (int n = 0; n < AdaptiveQueryCount; n++)
+    {
+        int index = (refine.nextQuery + n) % AdaptiveQueryCount;
+        if (!refine.queryPending[index])
+            continue;
+        GLuint available = 0;
+        glGetQueryObjectuiv(refine.queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        GLuint samples = 0;
+        glGetQueryObjectuiv(refine.queries[index], GL_QUERY_RESULT, &samples);
+        refine.queryPending[index] = false;
+        refine.tracedFraction = static_cast<double>(refine.queryCoarsePixels[index] + samples) / refine.queryPixels[index];
+        refine.tracedSum += refine.tracedFraction;
+        refine.measuredFrames++;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "blackhole_pass.h"
+#include "render_target.h"
+#include "shader_quality.h"
+
+// ڵѯֻ֮֡֡ض
+const int AdaptiveQueryCount = 4;
+
+// ֲӦֱʣ--adaptive <С>ÿ blockSize x blockSize ׷һߣ
+// ٰΧ 3x3 ֲֹ͡ɫݷжϿǷƽƽĿֱӲֵ
+// ֵķزģɸֻЩĹ߲
+// ϸ pass ڵѯʵ׷ٵ
+struct AdaptiveRefine
+{
+    int blockSize = 4;
+    float threshold = 0.03f;    // ٤Уɫֵ
+
+    // ֲǰ + ֹͣRGBA16Fݷ + ȨأRGBA32F
+    unsigned int coarseFbo = 0;
+    unsigned int coarseTextures[2] = {};
+    int coarseWidth = 0;
+    int coarseHeight = 0;
+    BlackholeProgram coarse[ShaderQualityCount];    // ȾĻʱһһӦ
+
+    // ȫֱʽģ建壨1 = Ҫϸ
+    RenderTarget target;
+    BlackholeProgram classify;
+
+    // ߵ֡ӿڣʱƻȥ
+    int outputFbo = 0;
+    int outputViewport[4] = {};
+
+    unsigned int queries[AdaptiveQueryCount] = {};
+    bool queryPending[AdaptiveQueryCount] = {};
+    long long queryPixels[AdaptiveQueryCount] = {};     // ѯʱ
+    long long queryCoarsePixels[AdaptiveQueryCount] = {};
+    int nextQuery = 0;
+    bool queryActive = false;
+
+    double tracedFraction = 1.0;    // صһ֡׷ٹߵرֲ
+    double tracedSum = 0.0;
+    long long measuredFrames = 0;
+};
+
+bool createAdaptiveRefine(AdaptiveRefine& refine, int blockSize, float threshold,
+    const char* vertexSource, const char* fragmentSource);
+void deleteAdaptiveRefine(AdaptiveRefine& refine);
+
+// µߵ֡ӿڣߴ仯ʱ·Ŀ꣩󶨴ֲĿ겢ʹ quality ӦĴֲ
+// Դȫı
+bool beginAdaptiveRefine(AdaptiveRefine& refine, ShaderQuality quality, int width, int height,
+    float time, float mouseX, float mouseY);
+// ȫֱĿ꣬ģΪ 1ʹ÷ƽдɫģ 0
+void beginAdaptiveClassify(AdaptiveRefine& refine, float time, float mouseX, float mouseY, int firstUnit);
+// ֮ĻֻģΪ 1 أʼڵѯ
+void beginAdaptiveTrace(AdaptiveRefine& refine);
+// ѯرģԣѽƵߵ֡岢ָӿ
+void endAdaptiveRefine(AdaptiveRefine& refine);
+
+// ضɵڵѯ tracedFraction
+void pollAdaptiveRefine(AdaptiveRefine& refine);
@@ -0,0 +1,103 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "background_cubemap.h"
+#include "program_cache.h"
+#include "shader_read.h"
+
+bool createBackgroundCubemap(BackgroundCubemap& cubemap, int size,
+    const char* vertexSource, const char* fragmentSource, const FullscreenQuad& quad)
+{
+    int maxSize = 0;
+    glGetIntegerv(GL_MAX_CUBE_MAP_TEXTURE_SIZE, &maxSize);
+    // 
+    if (size <= 0 || size > maxSize)
+    {
+        std::cout << "ͼߴ " << size << " Χ " << maxSize << "" << std::endl;
+        return false;
+    }
+
+    std::string fragment = injectShaderDefines(fragmentSource, "#define BAKE_BACKGROUND_CUBEMAP\n");
+    unsigned int program = createCachedShaderProgram(vertexSource, fragment.c_str());
+    if (program == 0)
+        return false;
+
+    auto start = std::chrono::steady_clock::now();
+
+    glGenTextures(1, &cubemap.tex);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.tex);
+    for (int face = 0; face < 6; face++)
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA16F, size, size, 0, GL_RGBA, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    // ֮䰴ˣӷ
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    int previousFbo = 0;
+    int previousViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    unsigned int fbo = 0;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, size, size);
+    glUseProgram(program);
+    int faceLoc = glGetUniformLocation(program, "iCubeFace");
+
+    bool complete = true;
+    for (int face = 0; face < 6 && complete; face++)
+    {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, cubemap.tex, 0);
+        complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glUniform1i(faceLoc, face);
+        drawFullscreenQuad(quad);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteProgram(program);
+
+    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.tex);
+    glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    glFinish();
+
+    cubemap.size = size;
+    cubemap.bakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // 
+    if (!complete || glGetError() != GL_NO_ERROR)
+    {
+        std::cout << "ͼ決ʧܣ" << std::endl;
+        deleteBackgroundCubemap(cubemap);
+        return false;
+    }
+    std::cout << "ͼ決ɣ6x" << size << "x" << size << "ʱ " << cubemap.bakeMs << " ms" << std::endl;
+    return true;
+}
+
+void deleteBackgroundCubemap(BackgroundCubemap& cubemap)
+{
+    glDeleteTextures(1, &cubemap.tex);
+    cubemap = BackgroundCubemap();
+}
+
+void bindBackgroundCubemap(const BackgroundCubemap& cubemap, unsigned int program, int unit, float resX)
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.tex);
+    glActiveTexture(GL_TEXTURE0);
+
+    // һԼӦ 1/resX ȣͼһԼ 2/size ȣ
+    // ֱʵͼʱȡֵ mip 㣬ǵ˸
+    float lod = std::max(0.0f, std::log2(cubemap.size / (2.0f * resX)));
+    glUniform1i(glGetUniformLocation(program, "iBackground"), unit);
+    glUniform1f(glGetUniformLocation(program, "iBackgroundLod"), lod);
+}
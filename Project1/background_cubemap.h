@@ -0,0 +1,21 @@
+#pragma once
+#include "fullscreen_quad.h"
+
+// Ԥ決ıͼblackhole.frag е background() ֻݹߵķ
+// ʱ䡢޹أ˻ỰʼʱȾһε mipmap ͼ
+// ֮ݹ߸Ϊһ textureLod  BACKGROUND_CUBEMAP
+struct BackgroundCubemap
+{
+    unsigned int tex = 0;
+    int size = 0;           // ÿı߳أ
+    double bakeMs = 0.0;
+};
+
+//  BAKE_BACKGROUND_CUBEMAP  6 Ⱦ RGBA16F ͼ mipmap
+// Ҫǰ GL ģָ֮ǰ󶨵֡ӿڣ
+bool createBackgroundCubemap(BackgroundCubemap& cubemap, int size,
+    const char* vertexSource, const char* fragmentSource, const FullscreenQuad& quad);
+void deleteBackgroundCubemap(BackgroundCubemap& cubemap);
+
+// 󶨵Ԫ unit program е iBackground / iBackgroundLodresX Ϊȣ
+void bindBackgroundCubemap(const BackgroundCubemap& cubemap, unsigned int program, int unit, float resX);
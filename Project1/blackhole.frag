@@ -1,39 +1,136 @@
 #version 330 core
+#if defined(GEODESIC_GBUFFER)
+// ߻ G-buffer geodesic_cache.h
+layout(location = 0) out vec4 FragColor;       // ݷ xyz + Թǿ
+layout(location = 1) out vec4 gCrossingRayY;   // δԽʱ |ray.y|0 ʾû
+layout(location = 2) out vec4 gCrossing[4];    // δԽʱ (pos.xz, ray.xz)
+#elif defined(ADAPTIVE_COARSE)
+// ֲӦֱʵĴֲ adaptive_refine.h
+layout(location = 0) out vec4 FragColor;       // ǰ + Թ⣬δ٤У+ ֹ
+layout(location = 1) out vec4 gEscape;         // ݷ xyz + Ȩ
+#elif defined(TAA)
+// ʱ俹ݵĶȾ temporal_aa.h
+layout(location = 0) out vec4 FragColor;       // ٤Уɫ + ռ
+layout(location = 1) out vec4 gMotion;         // ݷ + ǷԱΪ
+#elif defined(STEP_COUNTER)
+// ֲͳƣ step_counter.h
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out float gSteps;         // ÿߵƽ
+#else
 out vec4 FragColor;
+#endif
 
 in vec2 texCoord; // Ӷɫ
 
-// Shadertoy ĺ궨
+// Shadertoy ĺ궨壨Ⱦ #version ֮עͬ긲ǣ shader_quality.h
+#ifndef AA
 #define AA 1  // Ϊ 2 
+#endif
+#ifndef _Speed
 #define _Speed 3.0  // תٶ
+#endif
+#ifndef _Steps
 #define _Steps  12. // 
+#endif
+#ifndef _Size
 #define _Size 0.3   // ڶС
+#endif
+// ߲ѭÿּһ//棬ڲΪ
+// Ϊڳչѭ
+#ifndef DISK_ITERATIONS
+#define DISK_ITERATIONS 20
+#endif
+#ifndef BEND_STEPS
+#define BEND_STEPS 6
+#endif
+// ʱ俹ݡۻ֡ĵߴ AA*AA 
+#if defined(TAA) || defined(ACCUMULATE)
+#undef AA
+#define AA 1
+uniform vec2 iJitter;       // ֡ضأ
+#endif
+
+#if defined(ADAPTIVE_COARSE) || defined(TILE_PREPASS)
+#undef AA
+#define AA 1
+uniform int iBlockSize;     // ÿֲ iBlockSize x iBlockSize 
+#endif
+#ifdef REGION_RENDER
+// ֿȾ still_render.hӿֻһ飬iResolution ͼĳߴ
+uniform vec2 iRegionOffset;  // һ½ͼе
+#endif
+#if defined(ADAPTIVE_COARSE) || defined(TAA)
+vec4 escapeRecord = vec4(0.0);      // ݷ + ȨأδʱΪ 0
+#endif
+#ifdef STEP_COUNTER
+float stepCount = 0.0;      // йߵĻֲ
+#endif
 
 // Uniform Ӧ Shadertoy ñ
+#ifdef MULTI_VIEW
+// ͼ multi_view.hһʵȾͼеȫͼiResolution Ϊÿĳߴ磬
+// ͼ iTimeiMouse  uniform Уmain() ͷʵȡ
+layout(std140) uniform MultiViews
+{
+    vec4 iViews[MAX_VIEWS];     // xyiMouseziTime
+};
+flat in int viewIndex;
+float iTime;
+vec2 iMouse;
+#else
 uniform float iTime;       // ʱ
-uniform vec2 iResolution;  // ڷֱ
 uniform vec2 iMouse;       // λãһ
-uniform sampler2D iChannel0; // ͨͼΪ
+#endif
+uniform vec2 iResolution;  // ڷֱ
+uniform sampler2D iChannel0; // ͨͼΪNOISE_HASH_TEXTURE ʱΪϣ
 
-// ϣ
-float hash(float x){ return fract(sin(x)*152754.742);}
-float hash(vec2 x){	return hash(x.x + hash(x.y));}
+// ϣֵϣ˼ noise.glsl
+#include "noise.glsl"
 
-// ֵ
-float value(vec2 p, float f)
+#ifdef NOISE_BENCH
+// ϣ˵΢׼ noise_bench.hrNOISE_BENCH ͬƵʡƫƵ value() ƽʱã
+// gÿ 8 һ value()ͳƷֲbԻΪԭĸϣ CPU οʵλԱȣ
+vec4 noiseBench(vec2 fragCoord)
 {
-    float bl = hash(floor(p*f + vec2(0.,0.)));
-    float br = hash(floor(p*f + vec2(1.,0.)));
-    float tl = hash(floor(p*f + vec2(0.,1.)));
-    float tr = hash(floor(p*f + vec2(1.,1.)));
-    
-    vec2 fr = fract(p*f);    
-    fr = (3.0 - 2.0*fr)*fr*fr;	
-    float b = mix(bl, br, fr.x);	
-    float t = mix(tl, tr, fr.x);
-    return mix(b, t, fr.y);
+    vec2 p = fragCoord / iResolution.x;
+    float sum = 0.0;
+    for (int i = 0; i < NOISE_BENCH; i++)
+        sum += value(p + float(i)*vec2(0.37, 0.61), 100.0 + float(i));
+    return vec4(sum / float(NOISE_BENCH), value(fragCoord, 0.125), hash(floor(fragCoord) - floor(iResolution*0.5)), 1.0);
 }
+#endif
+
+#ifdef DISK_NOISE_TEXTURE
+// Ԥ決㣨 disk_noise.h (i, j) Ϊ hash(vec2(i, j))򶼰ߴѭ
+uniform sampler2D iDiskNoise;
 
+//  value() ͬ smoothstep ֵȨһ˫ԲõĸĻ
+float diskNoise(vec2 p, float f)
+{
+    vec2 size = vec2(textureSize(iDiskNoise, 0));
+    vec2 lattice = floor(p*f);
+    vec2 fr = fract(p*f);
+    fr = (3.0 - 2.0*fr)*fr*fr;
+    return textureLod(iDiskNoise, (mod(lattice, size) + fr + 0.5) / size, 0.0).r;
+}
+#else
+float diskNoise(vec2 p, float f)
+{
+    return value(p, f);
+}
+#endif
+
+#ifdef BACKGROUND_CUBEMAP
+// Ԥ決 background() background_cubemap.hֻ߷
+uniform samplerCube iBackground;
+uniform float iBackgroundLod;   // ضӦͼѡ mip 㼶
+
+vec4 background(vec3 ray)
+{
+    // ѭ;ݣ֧һʱʽ޶壬ʽָ LOD
+    return textureLod(iBackground, ray, iBackgroundLod);
+}
+#else
 // ǿ+ƣ iChannel0 Ϊ
 vec4 background(vec3 ray)
 {
@@ -60,6 +157,7 @@ vec4 background(vec3 ray)
     
     return nebulae;
 }
+#endif
 
 // ߲
 vec4 raymarchDisk(vec3 ray, vec3 zeroPos)
@@ -112,8 +210,8 @@ vec4 raymarchDisk(vec3 ray, vec3 zeroPos)
         float angle = 0.02*atan(x);
   
         const float f = 70.0;
-        float noise = value(vec2(angle, u * (1.0/_Size) * 0.05), f);
-        noise = noise*0.66 + 0.33*value(vec2(angle, u * (1.0/_Size) * 0.05), f*2.0);     
+        float noise = diskNoise(vec2(angle, u * (1.0/_Size) * 0.05), f);
+        noise = noise*0.66 + 0.33*diskNoise(vec2(angle, u * (1.0/_Size) * 0.05), f*2.0);     
 
         float extraWidth = noise * 1.0 * (1.0 - clamp(i * (1.0/_Steps)*2.0 - 1.0, 0.0, 1.0));
         float alpha = clamp(noise*(intensity + extraWidth)*( (1.0/_Size) * 10.0  + 0.01 ) * dist * distMult , 0.0, 1.0);
@@ -136,15 +234,741 @@ void Rotate(inout vec3 vector, vec2 angle)
     vector.xz = cos(angle.x)*vector.xz + sin(angle.x)*vec2(-1,1)*vector.zx;
 }
 
-void main()
+// ĻתԼ 10 Ȳƽ
+vec2 rotateFragCoord(vec2 fragCoord)
 {
-    vec2 fragCoord = texCoord * iResolution; // תΪShadertoyfragCoord
-    vec4 colOut = vec4(0.0);
-    
     vec2 fragCoordRot;
     fragCoordRot.x = fragCoord.x*0.985 + fragCoord.y * 0.174;
     fragCoordRot.y = fragCoord.y*0.985 - fragCoord.x * 0.174;
     fragCoordRot += vec2(-0.06, 0.12) * iResolution.xy;
+    return fragCoordRot;
+}
+
+// λãתǰ iMouse 
+vec3 cameraPosition(vec2 mouse)
+{
+    return vec3(0.0,0.05,-(20.0*mouse.xy/iResolution.y-10.0)*(20.0*mouse.xy/iResolution.y-10.0)*0.05);
+}
+
+// λõתǣiTime  y תiMouse.y 
+vec2 cameraAngle(float time, vec2 mouse)
+{
+    vec2 angle = vec2(time*0.1, 0.2);
+    angle.y = (2.0*mouse.y/iResolution.y)*3.14159 + 0.1 + 3.14159;
+    return angle;
+}
+
+// ߷תǣƫڶģ
+vec2 cameraRayAngle(float time, vec2 mouse)
+{
+    float dist = length(cameraPosition(mouse));
+    return cameraAngle(time, mouse) - min(0.3/dist , 3.14159) * vec2(1, 0.5);
+}
+
+#ifdef BAKE_BACKGROUND_CUBEMAP
+// 決ͼʱǰȾ棨GL_TEXTURE_CUBE_MAP_POSITIVE_X + iCubeFace
+uniform int iCubeFace;
+
+//  -> OpenGL ͼԼ
+vec3 cubemapFaceDirection(int face, vec2 st)
+{
+    vec2 c = st * 2.0 - 1.0;
+    vec3 dir;
+    if (face == 0)      dir = vec3(1.0, -c.y, -c.x);
+    else if (face == 1) dir = vec3(-1.0, -c.y, c.x);
+    else if (face == 2) dir = vec3(c.x, 1.0, c.y);
+    else if (face == 3) dir = vec3(c.x, -1.0, -c.y);
+    else if (face == 4) dir = vec3(c.x, -c.y, 1.0);
+    else                dir = vec3(-c.x, -c.y, -1.0);
+    return normalize(dir);
+}
+#endif
+
+#ifdef LENSING_LUT
+// Ԥ͸ұ lensing_lut.h (λ, ʼ) ųɵƽ˶
+uniform sampler2D iLensSummary; // (alpha, r0) -> ֹ, ䷽, Թ, ֹ
+uniform sampler3D iLensPath;    // (phi / ֹ, alpha, r0) -> 뾶, ߷
+uniform vec2 iLensRange;        //  r0 ķΧ
+
+#define MAX_DISK_CROSSINGS 4
+
+// òұ߲ѭѭʱͬ outCol
+vec4 traceLensingLut(vec3 ray, vec3 pos)
+{
+    // ƽĻe1 e2 Ϊǰ
+    float r0 = length(pos);
+    vec3 e1 = pos / r0;
+    float cosAlpha = clamp(dot(ray, e1), -1.0, 1.0);
+    vec3 tangent = ray - cosAlpha * e1;
+    vec3 e2 = length(tangent) > 1e-6 ? normalize(tangent) : normalize(cross(e1, vec3(0.0, 0.0, 1.0)));
+
+    vec2 uv = vec2(acos(cosAlpha) / 3.14159265, log(max(r0, iLensRange.x) / iLensRange.x) / log(iLensRange.y / iLensRange.x));
+
+    // ֹͺֹǲܿ/յıֵ߽Ӳ˫Բֵزͬʱ
+    // ˵㼣Խ˱߽磺أ·Ҳֻأȡģ
+    vec4 summary = texture(iLensSummary, uv);
+    vec2 lutSize = vec2(textureSize(iLensSummary, 0));
+    vec2 nearestUv = (min(floor(uv * lutSize), lutSize - 1.0) + 0.5) / lutSize;
+    vec4 nearestSummary = texture(iLensSummary, nearestUv);
+    bool mixedTypes = summary.w != nearestSummary.w;
+    summary = mixedTypes ? nearestSummary : summary;
+    uv = mixedTypes ? nearestUv : uv;
+    float phiEnd = summary.x;
+    vec4 glow = vec4(1.2, 1.1, 1.0, 1.0) * summary.z;
+    vec4 col = vec4(0.0);
+
+    //  y = 0 ƽĽߣr*(cos(phi)*e1.y + sin(phi)*e2.y) = 0ÿ pi һ
+    float phiNode = atan(-e1.y, e2.y);
+    if (phiNode < 0.0)
+        phiNode += 3.14159265;
+
+    for (int k = 0; k < MAX_DISK_CROSSINGS; k++)
+    {
+        float phi = phiNode + float(k) * 3.14159265;
+        if (phi >= phiEnd)
+            break;
+
+        vec2 path = texture(iLensPath, vec3(phi / phiEnd, uv)).xy;
+        if (path.x > _Size * 12.0)
+            continue;
+
+        vec3 crossPos = path.x * (cos(phi) * e1 + sin(phi) * e2);
+        vec3 crossRay = cos(path.y) * e1 + sin(path.y) * e2;
+        vec4 diskCol = raymarchDisk(crossRay, crossPos);
+        col = vec4(diskCol.rgb*(1.0-col.a) + col.rgb, col.a + diskCol.a*(1.0-col.a));
+    }
+
+    // ֹͣ0 ݣ1 ڶգ0.5 þ
+    if (summary.w > 0.75)
+        return vec4(col.rgb * col.a + glow.rgb * (1.0-col.a), 1.0);
+    if (summary.w < 0.25)
+    {
+        vec3 escapeRay = cos(summary.y) * e1 + sin(summary.y) * e2;
+#if defined(ADAPTIVE_COARSE) || defined(TAA)
+        escapeRecord = vec4(escapeRay, 1.0 - col.a);
+#endif
+#ifdef ADAPTIVE_COARSE
+        return vec4(col.rgb*col.a + glow.rgb*(1.0-col.a), 0.0);
+#endif
+        vec4 bg = background(escapeRay);
+        return vec4(col.rgb*col.a + bg.rgb*(1.0-col.a) + glow.rgb*(1.0-col.a), 1.0);
+    }
+#ifdef ADAPTIVE_COARSE
+    return vec4(col.rgb + glow.rgb*(col.a + glow.a), 0.5);
+#endif
+    return vec4(col.rgb + glow.rgb*(col.a + glow.a), 1.0);
+}
+#endif
+
+#if defined(GEODESIC_GBUFFER) || defined(GEODESIC_SHADE)
+// ߻棺ֻ iTime ı仯ֻ y תangle.x = iTime*0.1
+// ԳơΪ y = 0 y תǺϷ⣬ G-buffer  iTime = 0
+// ɣɫʱ潻ݷһתǰʱֻ̣ iMouse ıʱҪؽ
+#define MAX_CACHED_CROSSINGS 4
+#endif
+
+#ifdef GEODESIC_SHADE
+uniform sampler2D iGeodesic;            // ݷ xyzλ = ݣ0 = ɣ 2 = þ+ Թ
+uniform sampler2D iGeodesicRayY;
+uniform sampler2D iGeodesicCrossing0;
+uniform sampler2D iGeodesicCrossing1;
+uniform sampler2D iGeodesicCrossing2;
+uniform sampler2D iGeodesicCrossing3;
+
+// ֻ¼̣ iTime ͱֱӶ
+vec4 shadeGeodesicCache(ivec2 pixel)
+{
+    vec4 escape = texelFetch(iGeodesic, pixel, 0);
+    vec4 rayY = texelFetch(iGeodesicRayY, pixel, 0);
+    vec4 crossings[MAX_CACHED_CROSSINGS];
+    crossings[0] = texelFetch(iGeodesicCrossing0, pixel, 0);
+    crossings[1] = texelFetch(iGeodesicCrossing1, pixel, 0);
+    crossings[2] = texelFetch(iGeodesicCrossing2, pixel, 0);
+    crossings[3] = texelFetch(iGeodesicCrossing3, pixel, 0);
+    vec2 spin = vec2(iTime*0.1, 0.0);
+
+    vec4 col = vec4(0.0);
+    for (int k = 0; k < MAX_CACHED_CROSSINGS; k++)
+    {
+        if (rayY[k] == 0.0)
+            break;
+        // raymarchDisk ֻõ pos.xz  |ray.y|
+        vec3 pos = vec3(crossings[k].x, 0.0, crossings[k].y);
+        vec3 ray = vec3(crossings[k].z, rayY[k], crossings[k].w);
+        Rotate(pos, spin);
+        Rotate(ray, spin);
+        vec4 diskCol = raymarchDisk(ray, pos);
+        col = vec4(diskCol.rgb*(1.0-col.a) + col.rgb, col.a + diskCol.a*(1.0-col.a));
+    }
+
+    vec4 glow = vec4(1.2,1.1,1.0, 1.0) * escape.w;
+    float escapeLength = length(escape.xyz);
+    vec4 outCol;
+    if (escapeLength < 0.5)
+        outCol = vec4(col.rgb * col.a + glow.rgb * (1.0-col.a), 1.0);
+    else if (escapeLength < 1.5)
+    {
+        vec3 ray = escape.xyz;
+        Rotate(ray, spin);
+        vec4 bg = background(ray);
+        outCol = vec4(col.rgb*col.a + bg.rgb*(1.0-col.a) + glow.rgb*(1.0-col.a), 1.0);
+    }
+    else
+        outCol = vec4(col.rgb + glow.rgb*(col.a + glow.a), 1.0);
+
+    // ٤У
+    outCol.rgb = pow(outCol.rgb, vec3(0.6));
+    return outCol;
+}
+#endif
+
+#ifdef TAA_RESOLVE
+// ʱ俹ݵĽ pass temporal_aa.h
+uniform sampler2D iCurrent;     // ֡ȾĽa Ϊռ
+uniform sampler2D iHistory;     // һ֡Ľ
+uniform sampler2D iMotion;      // ֡ÿصݷռ䣩+ ǷԱΪ main() ĩβ
+uniform float iPrevTime;        // һ֡
+uniform vec2 iPrevMouse;
+uniform vec2 iJitter;           // ֡ضأ
+uniform float iBlend;           // 澲ֹʱ֡ĻȨ
+uniform float iMotionBlend;     // ˶ʱر֡ĻȨ
+uniform float iClipBlend;       // ˶ʱࣨüʷģر֡ĻȨ
+uniform int iHistoryValid;
+
+// üİΧа׼ı
+#ifndef TAA_VARIANCE_GAMMA
+#define TAA_VARIANCE_GAMMA 1.0
+#endif
+
+// iMouse ıʱĽƣѵǰصĳʼ߻һ֡£һ֡Ļ꣨ı仯
+vec2 previousBackgroundCoord(vec2 fragCoord)
+{
+    vec3 ray = normalize(vec3((rotateFragCoord(fragCoord) - iResolution.xy*0.5)/iResolution.x, 1.0));
+    Rotate(ray, cameraRayAngle(iTime, iMouse));
+
+    // Rotate 棺 y ᷴת x ᷴת
+    vec2 angle = -cameraRayAngle(iPrevTime, iPrevMouse);
+    ray.xz = cos(angle.x)*ray.xz + sin(angle.x)*vec2(-1,1)*ray.zx;
+    ray.yz = cos(angle.y)*ray.yz + sin(angle.y)*vec2(-1,1)*ray.zy;
+    if (ray.z <= 0.0)
+        return vec2(-1.0);
+
+    // rotateFragCoord 棨תʽΪ 0.985^2 + 0.174^2
+    vec2 rot = ray.xy / ray.z * iResolution.x + iResolution.xy*0.5 - vec2(-0.06, 0.12) * iResolution.xy;
+    return vec2(rot.x*0.985 - rot.y*0.174, rot.y*0.985 + rot.x*0.174) / (0.985*0.985 + 0.174*0.174);
+}
+
+// iMouse ʱ iTime ֻͬ y תڶ̵ĻϾֹͬһصݷ
+// ֮תһ֡ q ݷ d֡ q ݷ d  y תתǵĽǿ
+// ʼߵͶӰãڵǰظصĲְݷԻת d λã
+//  d һ֡ĻꡣزԱΪɡڵԻ˻ʱ false
+bool escapeOffset(ivec2 pixel, out vec2 offset)
+{
+    offset = vec2(0.0);
+    ivec2 maxPixel = ivec2(iResolution.xy) - 1;
+    ivec2 left = max(pixel - ivec2(1, 0), ivec2(0));
+    ivec2 right = min(pixel + ivec2(1, 0), maxPixel);
+    ivec2 down = max(pixel - ivec2(0, 1), ivec2(0));
+    ivec2 up = min(pixel + ivec2(0, 1), maxPixel);
+    vec4 escape = texelFetch(iMotion, pixel, 0);
+    vec4 leftEscape = texelFetch(iMotion, left, 0);
+    vec4 rightEscape = texelFetch(iMotion, right, 0);
+    vec4 downEscape = texelFetch(iMotion, down, 0);
+    vec4 upEscape = texelFetch(iMotion, up, 0);
+    if (min(min(escape.w, leftEscape.w), min(min(rightEscape.w, downEscape.w), upEscape.w)) == 0.0)
+        return false;
+
+    vec3 dx = (rightEscape.xyz - leftEscape.xyz) / float(right.x - left.x);
+    vec3 dy = (upEscape.xyz - downEscape.xyz) / float(up.y - down.y);
+    float angle = cameraAngle(iTime, iMouse).x - cameraAngle(iPrevTime, iMouse).x;
+    vec3 target = escape.xyz;
+    Rotate(target, vec2(angle, 0.0));
+    vec3 delta = target - escape.xyz;
+
+    // Сˣ[dx dy] * offset = delta
+    mat2 normal = mat2(dot(dx, dx), dot(dx, dy), dot(dx, dy), dot(dy, dy));
+    if (determinant(normal) <= 1e-4 * normal[0][0] * normal[1][1])
+        return false;
+    offset = inverse(normal) * vec2(dot(dx, delta), dot(dy, delta));
+    return true;
+}
+
+// /ɫȷ YCoCg ռ䣺ķϼУɫȷĲüᱻȵſ
+vec3 rgbToYCoCg(vec3 c)
+{
+    return vec3(dot(c, vec3(0.25, 0.5, 0.25)), dot(c, vec3(0.5, 0.0, -0.5)), dot(c, vec3(-0.25, 0.5, -0.25)));
+}
+
+vec3 yCoCgToRgb(vec3 c)
+{
+    return vec3(c.x + c.y - c.z, c.x + c.z, c.x - c.y - c.z);
+}
+
+// Catmull-Rom زʷ˫Ĩǵ㣨زÿ֡ģʷۻ
+// Թ˰ 4x4 غϳ 5 βĽȨغСʡȥ
+vec3 sampleHistoryCatmullRom(vec2 position)
+{
+    vec2 center = floor(position - 0.5) + 0.5;
+    vec2 f = position - center;
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+    vec2 w12 = w1 + w2;
+    vec2 uv0 = (center - 1.0) / iResolution.xy;
+    vec2 uv12 = (center + w2 / w12) / iResolution.xy;
+    vec2 uv3 = (center + 2.0) / iResolution.xy;
+
+    vec3 sum = texture(iHistory, vec2(uv12.x, uv0.y)).rgb * (w12.x * w0.y)
+        + texture(iHistory, vec2(uv0.x, uv12.y)).rgb * (w0.x * w12.y)
+        + texture(iHistory, uv12).rgb * (w12.x * w12.y)
+        + texture(iHistory, vec2(uv3.x, uv12.y)).rgb * (w3.x * w12.y)
+        + texture(iHistory, vec2(uv12.x, uv3.y)).rgb * (w12.x * w3.y);
+    float weight = w12.x * w0.y + w0.x * w12.y + w12.x * w12.y + w3.x * w12.y + w12.x * w3.y;
+    return max(sum / weight, vec3(0.0));
+}
+
+// ʷֱֵָؾֵ +- extent İΧУͨǯٸıɫࣩ
+vec3 clipToBox(vec3 history, vec3 center, vec3 extent)
+{
+    vec3 offset = history - center;
+    vec3 units = abs(offset) / max(extent, vec3(1e-4));
+    float outside = max(units.x, max(units.y, units.z));
+    return outside > 1.0 ? center + offset / outside : history;
+}
+
+// ֡ĵĹƣ3x3 ĵľ˹Ȩ Blackman-Harris
+// Ŀɴأ̵ڱ仯ֱܴӻϻѶ֡
+vec3 filterCurrent(ivec2 pixel)
+{
+    ivec2 maxPixel = ivec2(iResolution.xy) - 1;
+    vec3 sum = vec3(0.0);
+    float weight = 0.0;
+    for (int y = -1; y <= 1; y++)
+    for (int x = -1; x <= 1; x++)
+    {
+        vec2 d = vec2(x, y) + iJitter;
+        float w = exp(-3.0 * dot(d, d));
+        sum += w * texelFetch(iCurrent, clamp(pixel + ivec2(x, y), ivec2(0), maxPixel), 0).rgb;
+        weight += w;
+    }
+    return sum / weight;
+}
+
+vec4 resolveTaa(vec2 fragCoord)
+{
+    ivec2 pixel = ivec2(fragCoord);
+    vec4 current = texelFetch(iCurrent, pixel, 0);
+    // 澲ֹʱʷȫЧ֡Ķֱۻڵƽ
+    if (iHistoryValid != 0 && iTime == iPrevTime && iMouse == iPrevMouse)
+        return vec4(mix(texelFetch(iHistory, pixel, 0).rgb, current.rgb, iBlend), 1.0);
+
+    vec3 filtered = filterCurrent(pixel);
+    if (iHistoryValid == 0)
+        return vec4(filtered, 1.0);
+
+    // iMouse ʱݷͶӰıʱֻܰʼ߽Ʊ˶ռھֵֹ֮
+    vec2 offset = vec2(0.0);
+    bool escaped = false;
+    if (iMouse == iPrevMouse)
+        escaped = escapeOffset(pixel, offset);
+    else if (current.a > 0.0)
+        offset = current.a * (previousBackgroundCoord(fragCoord) - fragCoord);
+    vec2 previous = fragCoord + offset;
+    vec2 uv = previous / iResolution.xy;
+    if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0))))
+        return vec4(filtered, 1.0);
+    vec3 history = sampleHistoryCatmullRom(previous);
+
+    // ذݷͶӰǾȷģֻȡڷ򣩣ʷüصǵ㲻ᱻ֡ķֲص
+    // ڶ̵ĻϾֹ֡һ֡λôıռȾʷصıռȣ
+    // ߶ǴʱʷͬһƬǿ
+    if (escaped && min(current.a, texture(iCurrent, uv).a) > 0.99)
+        return vec4(mix(history, filtered, iMotionBlend), 1.0);
+
+    // 3x3  YCoCg ռľֵ׼ü̵ iTime ԭر仯޷ͶӰ
+    // ټڵԵʷȫɿü֡ķֲӰ
+    ivec2 maxPixel = ivec2(iResolution.xy) - 1;
+    vec3 moment1 = vec3(0.0);
+    vec3 moment2 = vec3(0.0);
+    for (int y = -1; y <= 1; y++)
+    for (int x = -1; x <= 1; x++)
+    {
+        vec3 c = rgbToYCoCg(texelFetch(iCurrent, clamp(pixel + ivec2(x, y), ivec2(0), maxPixel), 0).rgb);
+        moment1 += c;
+        moment2 += c * c;
+    }
+    vec3 mean = moment1 / 9.0;
+    vec3 sigma = sqrt(max(moment2 / 9.0 - mean * mean, vec3(0.0)));
+    history = yCoCgToRgb(clipToBox(rgbToYCoCg(history), mean, TAA_VARIANCE_GAMMA * sigma));
+    return vec4(mix(history, filtered, iClipBlend), 1.0);
+}
+#endif
+
+#ifdef ACCUMULATE_RESOLVE
+// ۻĽ pass accumulation.hƽ٤У
+uniform sampler2D iAccumulation;
+
+vec4 resolveAccumulation(vec2 uv)
+{
+    vec4 sum = texture(iAccumulation, uv);
+    return vec4(pow(sum.rgb / max(sum.a, 1.0), vec3(0.6)), 1.0);
+}
+#endif
+
+#ifdef ADAPTIVE_CLASSIFY
+// ֲӦֱʵķ pass adaptive_refine.hƽĿɴֲֵض
+// ֻ֮Ще߲
+uniform sampler2D iCoarseColor;     // ǰδ٤У+ ֹ
+uniform sampler2D iCoarseEscape;    // ݷ + Ȩ
+uniform int iBlockSize;
+uniform float iThreshold;           // ٤Уɫֵ
+
+// 鼰Χ 8 ֲֹͬɫֵݷĶײ㹻Сʱ
+// ڵ˫Բֵţֵֻõ 3x3 㣩
+bool smoothBlock(ivec2 block)
+{
+    ivec2 maxBlock = textureSize(iCoarseColor, 0) - 1;
+    vec4 center = texelFetch(iCoarseColor, block, 0);
+    vec3 low = pow(center.rgb, vec3(0.6));
+    vec3 high = low;
+    vec2 weightRange = vec2(texelFetch(iCoarseEscape, block, 0).w);
+    vec3 escape[9];
+    for (int y = -1; y <= 1; y++)
+    for (int x = -1; x <= 1; x++)
+    {
+        ivec2 p = clamp(block + ivec2(x, y), ivec2(0), maxBlock);
+        vec4 c = texelFetch(iCoarseColor, p, 0);
+        if (c.a != center.a)
+            return false;
+        vec3 g = pow(c.rgb, vec3(0.6));
+        low = min(low, g);
+        high = max(high, g);
+        vec4 e = texelFetch(iCoarseEscape, p, 0);
+        weightRange = vec2(min(weightRange.x, e.w), max(weightRange.y, e.w));
+        escape[(y + 1) * 3 + x + 1] = e.xyz;
+    }
+    if (any(greaterThan(high - low, vec3(iThreshold))) || weightRange.y - weightRange.x > iThreshold)
+        return false;
+
+    // ˫ԲֵԼΪײֵ 1/8ҪСڰضӦӽǣ1/iResolution.x
+    // ͼԵǯƺĲöײ˻Ϊһײ֣ԵĿܻᱻϸ
+    float limit = 4.0 / iResolution.x;
+    vec3 dx = escape[3] + escape[5] - 2.0 * escape[4];
+    vec3 dy = escape[1] + escape[7] - 2.0 * escape[4];
+    return length(dx) < limit && length(dy) < limit;
+}
+
+vec4 interpolateBlock(vec2 fragCoord)
+{
+    if (!smoothBlock(ivec2(fragCoord) / iBlockSize))
+        discard;
+
+    // ֲλڿģԹ˼Ϊ˫Բֵ
+    vec2 uv = fragCoord / (float(iBlockSize) * vec2(textureSize(iCoarseColor, 0)));
+    vec3 color = texture(iCoarseColor, uv).rgb;
+    vec4 escape = texture(iCoarseEscape, uv);
+    // ǵȿСֵķز
+    if (escape.w > 0.0)
+        color += background(normalize(escape.xyz)).rgb * escape.w;
+    return vec4(pow(color, vec3(0.6)), 1.0);
+}
+#endif
+
+#ifdef TILE_REDUCE
+// Ƭࣨ tile_classify.hƬȡĴֲ㼰һȦֵ
+// ֮ϸСӽĹӻӵı̣ڲ㶵ס
+uniform sampler2D iTileSamples;     // ÿ * 0.5
+uniform int iSamplesPerTile;
+
+float reduceTileClass(ivec2 tile)
+{
+    ivec2 maxSample = textureSize(iTileSamples, 0) - 1;
+    ivec2 first = tile * iSamplesPerTile;
+    float tileClass = 0.0;
+    for (int y = -1; y <= iSamplesPerTile; y++)
+    for (int x = -1; x <= iSamplesPerTile; x++)
+        tileClass = max(tileClass, texelFetch(iTileSamples, clamp(first + ivec2(x, y), ivec2(0), maxSample), 0).r);
+    return tileClass;
+}
+#endif
+
+#ifdef TILE_STENCIL
+// Ƭдģ壺Ͳ iTileClass ͨģ屻Ϊ iTileClass
+uniform sampler2D iTileClasses;
+uniform int iTileSize;
+uniform float iTileClass;
+#endif
+
+// ߴʱĴpos ΪϵĽ㣬ray Ϊʱķ
+// G-buffer Ƭ״̬ȫֱⷽʽ
+#ifdef GEODESIC_GBUFFER
+vec4 crossings[MAX_CACHED_CROSSINGS];
+vec4 crossingRayY = vec4(0.0);
+int crossingCount = 0;
+#endif
+#ifdef TILE_PREPASS
+bool diskVisible = false;
+#endif
+
+void crossDisk(vec3 ray, vec3 pos, inout vec4 col)
+{
+#if defined(GEODESIC_GBUFFER)
+    // ֻ¼㣬 MAX_CACHED_CROSSINGS ĴԽӻ
+    if (crossingCount < MAX_CACHED_CROSSINGS)
+    {
+        crossings[crossingCount] = vec4(pos.xz, ray.xz);
+        crossingRayY[crossingCount] = max(abs(ray.y), 1e-6);
+        crossingCount++;
+    }
+#elif defined(TILE_PREPASS)
+    // raymarchDisk ֻ뾶 10*_Size ɫΧعΪ +-0.2*_Size/|ray.y|
+    diskVisible = diskVisible || length(pos.xz) - 0.2*_Size/max(abs(ray.y), 1e-6) < _Size * 10.0;
+#elif defined(TILE_BACKGROUND)
+    // ֻбƬ㶼֮⣬raymarchDisk ĽΪ 0
+#else
+    vec4 diskCol = raymarchDisk(ray, pos);
+    col = vec4(diskCol.rgb*(1.0-col.a) + col.rgb, col.a + diskCol.a*(1.0-col.a));
+#endif
+}
+
+#ifdef WEAK_FIELD_EARLY_OUT
+// ƫۣ--weak-fieldѭʽ x' = vv' = a - (av)va = -k x / |x|^3У
+// 뾶ļн psi  r * sin(psi) * exp(k/r) = C غ㣬ľ r_min  r_min * exp(k/r_min) = C
+// ɴ C > R * exp(k/R) ֤߶ڰ뾶 R ֮⡣R С뾶ʱraymarchDisk Ĳ
+// ߵľ벻С sqrt(R^2 - (0.2 * _Size)^2)̶ûйףֱݡ
+// ƫ۽ k *  tan(psi) duu = 1/rԪ x = sin(psi)  k/C չһ׼˹̹ 2k/C
+// ݰ뾶ضϣ϶סض C = 3.3 ʱԼ 1.4e-4 
+#ifndef WEAK_FIELD_RADIUS
+#define WEAK_FIELD_RADIUS (_Size * 10.2)
+#endif
+
+// ƫ۽ǵı x^n / sqrt(1 - x^2)n = 1, 2, 3ԭ
+vec3 weakFieldTerms(float x)
+{
+    float c = sqrt(max(1.0 - x * x, 0.0));
+    return vec3(-c, 0.5 * (asin(x) - x * c), -c * (x * x + 2.0) * (1.0 / 3.0));
+}
+
+// ʱ ray ƫ۵ݷ򡢼;ĻԹⲢ truepos Ƶݰ뾶֮⣬ֻжֹ
+bool weakFieldEscape(inout vec3 pos, inout vec3 ray, inout vec4 glow)
+{
+    const float k = 0.625 * _Size;
+    const float escapeDist = _Size * 1000.0;
+    float dist = length(pos);
+    vec3 radial = pos / dist;
+    float cosPsi = dot(radial, ray);
+    float sinPsi = sqrt(max(1.0 - cosPsi * cosPsi, 0.0));
+    float C = dist * sinPsi * exp(k / dist);
+    if (C <= WEAK_FIELD_RADIUS * exp(k / WEAK_FIELD_RADIUS))
+        return false;
+
+    // sin(psi) 㵥仯ݰ뾶ķУcosPsi < 0Ĺ;ĵ sin(psi) = 1
+    float sinEscape = C / escapeDist * exp(-k / escapeDist);
+    vec3 terms = weakFieldTerms(sinPsi) - weakFieldTerms(sinEscape);
+    if (cosPsi < 0.0)
+        terms = 2.0 * weakFieldTerms(1.0) - weakFieldTerms(sinPsi) - weakFieldTerms(sinEscape);
+    float q = k / C;
+    float deflection = dot(terms, vec3(q, 2.0 * q * q, 4.5 * q * q * q));
+
+    // Թ 0.01 / r^4 ֱ߻֣r > 0.6 ʱ clamp Ϊ 1b ΪֱߵĽľ
+    float b = dist * sinPsi;
+    float s0 = dist * cosPsi;
+    float s1 = sqrt(escapeDist * escapeDist - b * b);
+    float glowEnd = s1 / (2.0 * b * b * (b * b + s1 * s1)) + atan(s1 / b) / (2.0 * b * b * b);
+    float glowStart = s0 / (2.0 * b * b * (b * b + s0 * s0)) + atan(s0 / b) / (2.0 * b * b * b);
+    glow += vec4(1.2, 1.1, 1.0, 1.0) * (0.01 * (glowEnd - glowStart));
+
+    // ڹڵƽת deflection
+    vec3 inward = (cosPsi * ray - radial) / sinPsi;
+    ray = normalize(cos(deflection) * ray + sin(deflection) * inward);
+    pos = ray * (escapeDist * 2.0);
+    return true;
+}
+#endif
+
+#ifdef RK45_INTEGRATOR
+// Ӧ--rk45Dormand-Prince 5(4)׽ƽǶĽ׽֮ÿľֲ
+// ֵѭ"һ"ʽx' = vv' = a - (av)va = -0.625 * _Size * x / |x|^3
+// Թ g' = 0.01 / |x|^4 * clamp(2|x| - 1.2, 0, 1)Сﲽ𲽷Ŵ󣬹򸽽ԶС
+#ifndef RK_TOLERANCE
+#define RK_TOLERANCE 1e-4   // ÿķλ
+#endif
+// ԭѭͬĲޣܾĲҲ
+#define RK_MAX_STEPS (DISK_ITERATIONS * BEND_STEPS)
+
+void rayDerivative(vec3 x, vec3 v, out vec3 dv, out float dg)
+{
+    float invDist = inversesqrt(dot(x, x));
+    float invDistSqr = invDist * invDist;
+    vec3 a = (-0.625 * _Size * invDistSqr * invDist) * x;
+    dv = a - dot(a, v) * v;
+    dg = 0.01 * invDistSqr * invDistSqr * clamp(2.0 / invDist - 1.2, 0.0, 1.0);
+}
+
+//  pos.y ʱλúͷ Hermite 潻
+void crossDiskHermite(vec3 x0, vec3 v0, vec3 x1, vec3 v1, float h, inout vec4 col)
+{
+    float t = x0.y / (x0.y - x1.y);
+    for (int i = 0; i < 2; i++)
+    {
+        float t2 = t * t;
+        float y = (2.0*t2*t - 3.0*t2 + 1.0) * x0.y + (t2*t - 2.0*t2 + t) * h * v0.y
+            + (3.0*t2 - 2.0*t2*t) * x1.y + (t2*t - t2) * h * v1.y;
+        float dy = (6.0*t2 - 6.0*t) * (x0.y - x1.y) + (3.0*t2 - 4.0*t + 1.0) * h * v0.y + (3.0*t2 - 2.0*t) * h * v1.y;
+        t = clamp(t - y / dy, 0.0, 1.0);
+    }
+    float t2 = t * t;
+    vec3 crossPos = (2.0*t2*t - 3.0*t2 + 1.0) * x0 + (t2*t - 2.0*t2 + t) * h * v0
+        + (3.0*t2 - 2.0*t2*t) * x1 + (t2*t - t2) * h * v1;
+    vec3 crossRay = (6.0*t2 - 6.0*t) * (x0 - x1) + (3.0*t2 - 4.0*t + 1.0) * h * v0 + (3.0*t2 - 2.0*t) * h * v1;
+    crossPos.y = 0.0;
+    crossDisk(normalize(crossRay), crossPos, col);
+}
+
+// ֵɡݻþֹжԭѭͬ
+void integrateRk45(inout vec3 pos, inout vec3 ray, inout vec4 col, inout vec4 glow)
+{
+    float g = 0.0;
+    float h = 0.1 * length(pos);
+    vec3 a1;
+    float g1;
+    rayDerivative(pos, ray, a1, g1);
+    for (int i = 0; i < RK_MAX_STEPS; i++)
+    {
+#ifdef STEP_COUNTER
+        stepCount += 1.0;
+#endif
+        float dist = length(pos);
+        h = min(h, dist);   // һĵľ룬Խڶ
+
+        vec3 v1 = ray;
+        vec3 v2 = ray + h * (1.0/5.0) * a1;
+        vec3 a2; float g2;
+        rayDerivative(pos + h * (1.0/5.0) * v1, v2, a2, g2);
+        vec3 v3 = ray + h * ((3.0/40.0) * a1 + (9.0/40.0) * a2);
+        vec3 a3; float g3;
+        rayDerivative(pos + h * ((3.0/40.0) * v1 + (9.0/40.0) * v2), v3, a3, g3);
+        vec3 v4 = ray + h * ((44.0/45.0) * a1 - (56.0/15.0) * a2 + (32.0/9.0) * a3);
+        vec3 a4; float g4;
+        rayDerivative(pos + h * ((44.0/45.0) * v1 - (56.0/15.0) * v2 + (32.0/9.0) * v3), v4, a4, g4);
+        vec3 v5 = ray + h * ((19372.0/6561.0) * a1 - (25360.0/2187.0) * a2 + (64448.0/6561.0) * a3 - (212.0/729.0) * a4);
+        vec3 a5; float g5;
+        rayDerivative(pos + h * ((19372.0/6561.0) * v1 - (25360.0/2187.0) * v2 + (64448.0/6561.0) * v3 - (212.0/729.0) * v4), v5, a5, g5);
+        vec3 v6 = ray + h * ((9017.0/3168.0) * a1 - (355.0/33.0) * a2 + (46732.0/5247.0) * a3 + (49.0/176.0) * a4 - (5103.0/18656.0) * a5);
+        vec3 a6; float g6;
+        rayDerivative(pos + h * ((9017.0/3168.0) * v1 - (355.0/33.0) * v2 + (46732.0/5247.0) * v3 + (49.0/176.0) * v4 - (5103.0/18656.0) * v5), v6, a6, g6);
+
+        // ׽⣻ĩһ׼FSAL
+        vec3 nextPos = pos + h * ((35.0/384.0) * v1 + (500.0/1113.0) * v3 + (125.0/192.0) * v4 - (2187.0/6784.0) * v5 + (11.0/84.0) * v6);
+        vec3 nextRay = ray + h * ((35.0/384.0) * a1 + (500.0/1113.0) * a3 + (125.0/192.0) * a4 - (2187.0/6784.0) * a5 + (11.0/84.0) * a6);
+        float nextG = g + h * ((35.0/384.0) * g1 + (500.0/1113.0) * g3 + (125.0/192.0) * g4 - (2187.0/6784.0) * g5 + (11.0/84.0) * g6);
+        vec3 a7; float g7;
+        rayDerivative(nextPos, nextRay, a7, g7);
+
+        // ׽Ľ׽֮
+        vec3 posError = h * ((71.0/57600.0) * v1 - (71.0/16695.0) * v3 + (71.0/1920.0) * v4 - (17253.0/339200.0) * v5 + (22.0/525.0) * v6 - (1.0/40.0) * nextRay);
+        vec3 rayError = h * ((71.0/57600.0) * a1 - (71.0/16695.0) * a3 + (71.0/1920.0) * a4 - (17253.0/339200.0) * a5 + (22.0/525.0) * a6 - (1.0/40.0) * a7);
+        float error = max(length(posError) / dist, length(rayError)) * (1.0 / RK_TOLERANCE);
+        float scale = clamp(0.9 * pow(max(error, 1e-6), -0.2), 0.2, 5.0);
+        if (error > 1.0)
+        {
+            h *= scale;
+            continue;
+        }
+
+        if ((pos.y > 0.0) != (nextPos.y > 0.0))
+            crossDiskHermite(pos, ray, nextPos, nextRay, h, col);
+        pos = nextPos;
+        ray = nextRay;
+        g = nextG;
+        a1 = a7;
+        g1 = g7;
+        h *= scale;
+
+        dist = length(pos);
+#ifndef TILE_DISK
+        if (dist < _Size * 0.1)
+            break;
+#endif
+        if (dist > _Size * 1000.0)
+            break;
+    }
+    // |v| ڷ±Ϊ 1v'  v ֱֻۻ
+    ray = normalize(ray);
+    glow = vec4(1.2, 1.1, 1.0, 1.0) * g;
+}
+#endif
+
+void main()
+{
+#ifdef GEODESIC_SHADE
+    FragColor = shadeGeodesicCache(ivec2(gl_FragCoord.xy));
+    return;
+#endif
+
+#ifdef BAKE_BACKGROUND_CUBEMAP
+    FragColor = background(cubemapFaceDirection(iCubeFace, texCoord));
+    return;
+#endif
+
+#ifdef NOISE_BENCH
+    FragColor = noiseBench(gl_FragCoord.xy);
+    return;
+#endif
+
+#ifdef BAKE_DISK_NOISE
+    //  value() еĸֵͬ
+    FragColor = vec4(hash(floor(gl_FragCoord.xy)));
+    return;
+#endif
+
+#ifdef TAA_RESOLVE
+    FragColor = resolveTaa(gl_FragCoord.xy);
+    return;
+#endif
+
+#ifdef ACCUMULATE_RESOLVE
+    FragColor = resolveAccumulation(texCoord);
+    return;
+#endif
+
+#ifdef ADAPTIVE_CLASSIFY
+    FragColor = interpolateBlock(gl_FragCoord.xy);
+    return;
+#endif
+
+#ifdef TILE_REDUCE
+    FragColor = vec4(reduceTileClass(ivec2(gl_FragCoord.xy)));
+    return;
+#endif
+
+#ifdef TILE_STENCIL
+    if (texelFetch(iTileClasses, ivec2(gl_FragCoord.xy) / iTileSize, 0).r * 2.0 < iTileClass - 0.25)
+        discard;
+    FragColor = vec4(0.0);
+    return;
+#endif
+
+#ifdef MULTI_VIEW
+    iMouse = iViews[viewIndex].xy;
+    iTime = iViews[viewIndex].z;
+#endif
+    vec2 fragCoord = texCoord * iResolution; // תΪShadertoyfragCoord
+#ifdef REGION_RENDER
+    // texCoord ֻ統ǰһ飬ôϿƫ
+    fragCoord = gl_FragCoord.xy + iRegionOffset;
+#endif
+#if defined(ADAPTIVE_COARSE) || defined(TILE_PREPASS)
+    fragCoord = gl_FragCoord.xy * float(iBlockSize);    // 
+#endif
+
+    vec4 colOut = vec4(0.0);
+#if defined(TAA) || defined(ACCUMULATE)
+    fragCoord += iJitter;
+#endif
+    
+    vec2 fragCoordRot = rotateFragCoord(fragCoord);
     
     // ѭ
     for( int j=0; j<AA; j++ )
@@ -152,72 +976,191 @@ void main()
     {
         // ʼ
         vec3 ray = normalize(vec3((fragCoordRot - iResolution.xy*0.5 + vec2(i,j)/float(AA))/iResolution.x, 1.0)); 
-        vec3 pos = vec3(0.0,0.05,-(20.0*iMouse.xy/iResolution.y-10.0)*(20.0*iMouse.xy/iResolution.y-10.0)*0.05); 
-        vec2 angle = vec2(iTime*0.1, 0.2);      
-        angle.y = (2.0*iMouse.y/iResolution.y)*3.14159 + 0.1 + 3.14159;
-        float dist = length(pos);
-        
-        Rotate(pos, angle);
-        angle.xy -= min(0.3/dist , 3.14159) * vec2(1, 0.5);
-        Rotate(ray, angle);
+        vec3 pos = cameraPosition(iMouse); 
+#ifdef GEODESIC_GBUFFER
+        float time = 0.0;    // ʱתɫʱת
+#else
+        float time = iTime;
+#endif
+        Rotate(pos, cameraAngle(time, iMouse));
+        Rotate(ray, cameraRayAngle(time, iMouse));
 
+#ifdef LENSING_LUT
+        vec4 outCol = traceLensingLut(ray, pos);
+#else
         vec4 col = vec4(0.0); 
         vec4 glow = vec4(0.0); 
-        vec4 outCol = vec4(100.0);
 
+#ifdef WEAK_FIELD_EARLY_OUT
+        // еĹ߽ݣѭ
+        if (!weakFieldEscape(pos, ray, glow))
+#endif
+#ifdef RK45_INTEGRATOR
+        integrateRk45(pos, ray, col, glow);
+#else
         // ߲ѭ
-        for(int disks = 0; disks< 20; disks++)
+        for(int disks = 0; disks< DISK_ITERATIONS; disks++)
         {
-            for (int h = 0; h < 6; h++)
+#ifdef ANALYTIC_DISK_CROSSING
+            bool crossed = false;
+            vec3 crossPos, crossRay;
+#endif
+            for (int h = 0; h < BEND_STEPS; h++)
             {
+#ifdef STEP_COUNTER
+                stepCount += 1.0;
+#endif
                 float dotpos = dot(pos, pos);
                 float invDist = inversesqrt(dotpos);
                 float centDist = dotpos * invDist; 	
-                float stepDist = 0.92 * abs(pos.y / (ray.y + 1e-6)); // 0
                 float farLimit = centDist * 0.5;
                 float closeLimit = centDist*0.1 + 0.05*centDist*centDist*(1.0/_Size);
+#ifdef ANALYTIC_DISK_CROSSING
+                // ֻƣ𲽱ƽ
+                float stepDist = min(farLimit, closeLimit);
+#else
+                float stepDist = 0.92 * abs(pos.y / (ray.y + 1e-6)); // 0
                 stepDist = min(stepDist, min(farLimit, closeLimit));
+#endif
 				
                 float invDistSqr = invDist * invDist;
                 float bendForce = stepDist * invDistSqr * _Size * 0.625;
                 ray = normalize(ray - (bendForce * invDist )*pos);
+#ifdef ANALYTIC_DISK_CROSSING
+                // һ֮ pos.y ż棬һֱϰ y Բֵõ
+                // ɫŵڲѭ֮ڲѭֻһ raymarchDisk Ĵ룬
+                // ڲͬĲʱҲᷴ¼֣ÿһδԽ
+                vec3 prevPos = pos;
+                pos += stepDist * ray;
+                if ((prevPos.y > 0.0) != (pos.y > 0.0))
+                {
+                    crossPos = mix(prevPos, pos, prevPos.y / (prevPos.y - pos.y));
+                    crossPos.y = 0.0;
+                    crossRay = ray;
+                    crossed = true;
+                }
+#else
                 pos += stepDist * ray; 
+#endif
                 
                 glow += vec4(1.2,1.1,1.0, 1.0) * (0.01*stepDist * invDistSqr * invDistSqr * clamp(centDist*2.0 - 1.2, 0.0, 1.0));
+#ifdef ANALYTIC_DISK_CROSSING
+                if (crossed)
+                    break;
+#endif
             }
 
+#ifdef ANALYTIC_DISK_CROSSING
+            if (crossed)
+                crossDisk(crossRay, crossPos, col);
+#endif
             float dist2 = length(pos);
 
-            // ߱ڶ
+            // ɻʱɫѭ֮λý
+#ifndef TILE_DISK
+            // ̵ƬûбɵĹߣж
             if(dist2 < _Size * 0.1)
-            {
-                outCol = vec4(col.rgb * col.a + glow.rgb * (1.0-col.a), 1.0);
                 break;
-            }
-            // ݵ
-            else if(dist2 > _Size * 1000.0)
-            {                   
-                vec4 bg = background(ray);
-                outCol = vec4(col.rgb*col.a + bg.rgb*(1.0-col.a) + glow.rgb*(1.0-col.a), 1.0);       
+#endif
+            if(dist2 > _Size * 1000.0)
                 break;
-            }
             // ߻
+#ifndef ANALYTIC_DISK_CROSSING
             else if (abs(pos.y) <= _Size * 0.002 )
             {                             
-                vec4 diskCol = raymarchDisk(ray, pos);
+                crossDisk(ray, pos, col);
                 pos.y = 0.0;
                 pos += abs(_Size * 0.001 / (ray.y + 1e-6)) * ray;  
-                col = vec4(diskCol.rgb*(1.0-col.a) + col.rgb, col.a + diskCol.a*(1.0-col.a));
             }	
+#endif
         }
-   
-        if(outCol.r == 100.0)
+
+#endif
+
+        // ֹλжϣѭ break һ
+        float endDist = length(pos);
+
+#ifdef TILE_PREPASS
+        // Ƭͣ0 ֻб1 ̣2 ɻþӻ
+        float tileClass = endDist > _Size * 1000.0 ? (diskVisible ? 1.0 : 0.0) : 2.0;
+        FragColor = vec4(tileClass * 0.5);
+        return;
+#endif
+
+#ifdef GEODESIC_GBUFFER
+        if (endDist < _Size * 0.1)
+            FragColor = vec4(vec3(0.0), glow.a);
+        else if (endDist > _Size * 1000.0)
+            FragColor = vec4(ray, glow.a);
+        else
+            FragColor = vec4(2.0, 0.0, 0.0, glow.a);
+        // Ƭֻó±ꣻδʹõĲλ crossingRayY Ϊ 0 
+        gCrossingRayY = crossingRayY;
+        gCrossing[0] = crossings[0];
+        gCrossing[1] = crossings[1];
+        gCrossing[2] = crossings[2];
+        gCrossing[3] = crossings[3];
+        return;
+#endif
+
+        vec4 outCol;
+#ifndef TILE_DISK
+        // ߱ڶ
+        if (endDist < _Size * 0.1)
+            outCol = vec4(col.rgb * col.a + glow.rgb * (1.0-col.a), 1.0);
+        else
+#endif
+        // ݵ
+        if (endDist > _Size * 1000.0)
+        {
+            vec4 bg = background(ray);
+            outCol = vec4(col.rgb*col.a + bg.rgb*(1.0-col.a) + glow.rgb*(1.0-col.a), 1.0);       
+#if defined(ADAPTIVE_COARSE) || defined(TAA)
+            escapeRecord = vec4(ray, 1.0 - col.a);
+#endif
+#ifdef ADAPTIVE_COARSE
+            // ϸ pass ֵķ²
+            outCol = vec4(col.rgb*col.a + glow.rgb*(1.0-col.a), 0.0);
+#endif
+        }
+        // þ
+        else
+        {
             outCol = vec4(col.rgb + glow.rgb*(col.a + glow.a), 1.0);
+#ifdef ADAPTIVE_COARSE
+            outCol.a = 0.5; // ֹͣ0 ݣ1 ɣ0.5 þ
+#endif
+        }
+#endif
 
         colOut += outCol / float(AA*AA);
     }
     
+#ifdef ADAPTIVE_COARSE
+    // ٤Уֵϱ֮
+    FragColor = colOut;
+    gEscape = escapeRecord;
+    return;
+#endif
+
+#ifdef ACCUMULATE
+    // ɫӷϵۻ壬a  AA һƽ٤У accumulation.h
+    FragColor = vec4(colOut.rgb, 1.0);
+    return;
+#endif
+
     // ٤У
     colOut.rgb = pow(colOut.rgb, vec3(0.6));
+#ifdef TAA
+    // ռݷ򹩽 pass ͶӰԱΪʱ w Ϊ 1Ϊ 0ĻϾֹ
+    colOut.a = escapeRecord.w;
+    if (escapeRecord.w > 0.5)
+        gMotion = vec4(escapeRecord.xyz, 1.0);
+    else
+        gMotion = vec4(0.0);
+#endif
+#ifdef STEP_COUNTER
+    gSteps = stepCount / float(AA*AA);
+#endif
     FragColor = colOut;
 }
\ No newline at end of file
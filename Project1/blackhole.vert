@@ -5,8 +5,21 @@ layout (location = 1) in vec2 aTexCoord;
 
 out vec2 texCoord; // Ƭɫ
 
+#ifdef MULTI_VIEW
+// ͼ multi_view.h gl_InstanceID ʵıŵͼеĵ gl_InstanceID У
+uniform int iViewColumns;   // ͼ
+uniform int iViewRows;      // ͼ
+flat out int viewIndex;
+#endif
+
 void main()
 {
     gl_Position = vec4(aPos, 0.0, 1.0);
     texCoord = aTexCoord;
+#ifdef MULTI_VIEW
+    vec2 grid = vec2(iViewColumns, iViewRows);
+    vec2 cell = vec2(gl_InstanceID % iViewColumns, gl_InstanceID / iViewColumns);
+    gl_Position.xy = (aTexCoord + cell) / grid * 2.0 - 1.0;
+    viewIndex = gl_InstanceID;
+#endif
 }
\ No newline at end of file
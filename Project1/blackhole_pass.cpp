@@ -0,0 +1,50 @@
+#include <glad/glad.h>
+#include "blackhole_pass.h"
+#include "program_cache.h"
+
+BlackholeProgram createBlackholeProgram(const char* vertexSource, const char* fragmentSource)
+{
+    BlackholeProgram bh;
+    bh.program = createCachedShaderProgram(vertexSource, fragmentSource);
+    if (bh.program == 0)
+        return bh;
+
+    // ȡUniformλãڴݣ
+    bh.iTimeLoc = glGetUniformLocation(bh.program, "iTime");
+    bh.iResolutionLoc = glGetUniformLocation(bh.program, "iResolution");
+    bh.iMouseLoc = glGetUniformLocation(bh.program, "iMouse");
+    bh.iChannel0Loc = glGetUniformLocation(bh.program, "iChannel0");
+    return bh;
+}
+
+void deleteBlackholeProgram(BlackholeProgram& bh)
+{
+    glDeleteProgram(bh.program);
+    bh = BlackholeProgram();
+}
+
+void useBlackholeProgram(const BlackholeProgram& bh, float time, float resX, float resY, float mouseX, float mouseY)
+{
+    // ʹɫ
+    glUseProgram(bh.program);
+
+    //  Uniform 
+    glUniform1f(bh.iTimeLoc, time);
+    glUniform2f(bh.iResolutionLoc, resX, resY);
+    glUniform2f(bh.iMouseLoc, mouseX, mouseY);
+    glUniform1i(bh.iChannel0Loc, 0); // Ԫ 0  iChannel0
+}
+
+unsigned int createDummyTexture()
+{
+    unsigned int tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    // 1x1İɫ
+    unsigned char data[] = { 255, 255, 255, 255 };
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    // 
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return tex;
+}
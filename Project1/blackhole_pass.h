@@ -0,0 +1,23 @@
+#pragma once
+
+//  blackhole.frag е _Size һ£CPU ˺決ұʱʹã
+const float BlackholeSize = 0.3f;
+
+// ڶɫ uniform λ
+struct BlackholeProgram
+{
+    unsigned int program = 0;
+    int iTimeLoc = -1;
+    int iResolutionLoc = -1;
+    int iMouseLoc = -1;
+    int iChannel0Loc = -1;
+};
+
+BlackholeProgram createBlackholeProgram(const char* vertexSource, const char* fragmentSource);
+void deleteBlackholeProgram(BlackholeProgram& bh);
+
+// ʹó uniformmouseX/mouseY Ϊ꣬ Shadertoy һ£
+void useBlackholeProgram(const BlackholeProgram& bh, float time, float resX, float resY, float mouseX, float mouseY);
+
+// iChannel0ɫδ
+unsigned int createDummyTexture();
@@ -0,0 +1,418 @@
+#include <glad/glad.h>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "blackhole_renderer.h"
+#include "shader_read.h"
+#include "program_cache.h"
+
+// Ԫ䣺0 Ϊ iChannel0dummy ϣ1/2 Ϊ͸ұ3 Ϊͼ
+// 4 Ϊ G-buffer4 ~ 9ӦϸĴֲ߻⣩10 Ϊ
+static const int LensSummaryUnit = 1;
+static const int LensPathUnit = 2;
+static const int BackgroundUnit = 3;
+static const int GeodesicUnit = 4;
+static const int AdaptiveUnit = 4;
+static const int DiskNoiseUnit = 10;
+
+bool createBlackholeRenderer(BlackholeRenderer& renderer, const RenderConfig& config,
+    const char* vertexSource, const char* fragmentSource)
+{
+    auto start = std::chrono::steady_clock::now();
+    ProgramCacheStats before = programCacheStats();
+
+    // ߻ȡصѭ͸ұ
+    renderer.geodesicCache = config.geodesicCache;
+    renderer.lensingLut = config.lensingLut && !config.geodesicCache;
+    if (config.lensingLut && config.geodesicCache)
+        std::cout << "߻ã --lensing-lut" << std::endl;
+    // ÿ֡Ĺ߶ͬ߻޷
+    renderer.taa = config.taa && !config.geodesicCache;
+    if (config.taa && config.geodesicCache)
+        std::cout << "߻ã --taa" << std::endl;
+    // Ӧϸ֡׷ٽ߻桢ʱ俹ݶ
+    renderer.adaptive = config.adaptiveBlock > 0 && !config.geodesicCache && !renderer.taa;
+    if (config.adaptiveBlock > 0 && !renderer.adaptive)
+        std::cout << "߻ʱ俹ã --adaptive" << std::endl;
+    // Ƭѭеķ֧͸ұ߻ûѭ
+    // ʱ俹ݺӦϸԽӹٵ
+    renderer.tileClassify = config.tileClassify && !config.geodesicCache && !renderer.lensingLut &&
+        !renderer.taa && !renderer.adaptive;
+    if (config.tileClassify && !renderer.tileClassify)
+        std::cout << "͸ұ߻桢ʱ俹ݻӦϸã --tile-classify" << std::endl;
+    // ۻÿλһߣӹظýķʽ
+    renderer.accumulate = config.stillSamples > 0 && !config.geodesicCache && !renderer.taa && !renderer.adaptive &&
+        !renderer.tileClassify;
+    if (config.stillSamples > 0 && !renderer.accumulate)
+        std::cout << "߻桢ʱ俹ݡӦϸƬã޷ۻ" << std::endl;
+    // ֿȾʱ iResolution ͼ񣬰 resX/resY Ŀķʽ
+    renderer.region = config.stillTile > 0 && !config.geodesicCache && !renderer.taa && !renderer.adaptive &&
+        !renderer.tileClassify;
+    if (config.stillTile > 0 && !renderer.region)
+        std::cout << "߻桢ʱ俹ݡӦϸƬã޷ֿȾ" << std::endl;
+    // ͳҪӹֱֻӻƵѭ
+    renderer.countSteps = config.countSteps && !config.geodesicCache && !renderer.lensingLut &&
+        !renderer.taa && !renderer.adaptive && !renderer.tileClassify && !renderer.accumulate && !renderer.region;
+    if (config.countSteps && !renderer.countSteps)
+        std::cout << "͸ұ߻桢ʱ俹ݡӦϸƬࡢۻֿȾã --count-steps" << std::endl;
+    // ͼÿʵֻͼеһ񣬰Ŀм仺ӹķʽ
+    renderer.multiView = config.views > 0 && !config.geodesicCache && !renderer.taa && !renderer.adaptive &&
+        !renderer.tileClassify && !renderer.accumulate && !renderer.region && !renderer.countSteps;
+    if (config.views > 0 && !renderer.multiView)
+        std::cout << "߻桢ʱ俹ݡӦϸƬࡢۻֿȾͳã޷ͼȾ" << std::endl;
+
+    // ϣе value() ĳ򣨰ͼĺ決ֱעԴ
+    renderer.noiseHash = config.noiseHash;
+    std::string noiseSource = injectShaderDefines(fragmentSource, noiseHashDefines(config.noiseHash));
+    fragmentSource = noiseSource.c_str();
+
+    std::string defines;
+    if (renderer.lensingLut)
+        defines += "#define LENSING_LUT\n";
+    if (config.backgroundCubemap > 0)
+        defines += "#define BACKGROUND_CUBEMAP\n";
+    if (config.diskNoiseTexture)
+        defines += "#define DISK_NOISE_TEXTURE\n";
+    if (renderer.taa)
+        defines += "#define TAA\n";
+    if (renderer.countSteps)
+        defines += "#define STEP_COUNTER\n";
+    if (renderer.accumulate)
+        defines += "#define ACCUMULATE\n";
+    if (renderer.region)
+        defines += "#define REGION_RENDER\n";
+    // ͼʱĶɫҲҪʵŷı
+    std::string viewVertex;
+    const char* mainVertexSource = vertexSource;
+    if (renderer.multiView)
+    {
+        std::string viewDefines = "#define MULTI_VIEW\n#define MAX_VIEWS " + std::to_string(MaxViews) + "\n";
+        defines += viewDefines;
+        viewVertex = injectShaderDefines(vertexSource, viewDefines);
+        mainVertexSource = viewVertex.c_str();
+    }
+
+    // ַʽѭкѭĳG-bufferƬ׷ٵȣһл
+    // ӦԴ潻
+    std::string integratorDefines;
+    if (config.rk45)
+    {
+        std::ostringstream tolerance;
+        tolerance << std::scientific << config.rkTolerance;
+        integratorDefines = "#define RK45_INTEGRATOR\n#define RK_TOLERANCE " + tolerance.str() + "\n";
+        if (config.analyticCrossing)
+            std::cout << "ӦԴ潻㣬 --analytic-crossing" << std::endl;
+    }
+    else if (config.analyticCrossing)
+        integratorDefines = "#define ANALYTIC_DISK_CROSSING\n";
+    if (config.weakField)
+        integratorDefines += "#define WEAK_FIELD_EARLY_OUT\n";
+
+    // ʱֻں궨ϲͬʱһαãʱлûп
+    for (int i = 0; i < ShaderQualityCount; i++)
+    {
+        ShaderQuality quality = static_cast<ShaderQuality>(i);
+        if (!config.allQualities && quality != config.quality)
+            continue;
+
+        std::string qualityDefines = shaderQualityDefines(quality) + integratorDefines;
+        std::string fragment = injectShaderDefines(fragmentSource, qualityDefines + defines +
+            (renderer.geodesicCache ? "#define GEODESIC_SHADE\n" : ""));
+        renderer.qualities[i] = createBlackholeProgram(mainVertexSource, fragment.c_str());
+        if (renderer.qualities[i].program == 0)
+        {
+            deleteBlackholeRenderer(renderer);
+            return false;
+        }
+
+        // ߻ G-buffer ѭ滭ʱ仯
+        if (renderer.geodesicCache)
+        {
+            fragment = injectShaderDefines(fragmentSource, qualityDefines + "#define GEODESIC_GBUFFER\n");
+            renderer.geodesic.gbuffer[i] = createBlackholeProgram(vertexSource, fragment.c_str());
+            if (renderer.geodesic.gbuffer[i].program == 0)
+            {
+                deleteBlackholeRenderer(renderer);
+                return false;
+            }
+        }
+
+        // ӦϸĴֲ׷ʹͬĻʺ͸ұ/ѡ
+        if (renderer.adaptive)
+        {
+            fragment = injectShaderDefines(fragmentSource, qualityDefines + defines + "#define ADAPTIVE_COARSE\n");
+            renderer.refine.coarse[i] = createBlackholeProgram(vertexSource, fragment.c_str());
+            if (renderer.refine.coarse[i].program == 0)
+            {
+                deleteBlackholeRenderer(renderer);
+                return false;
+            }
+        }
+
+        // Ƭࣺ׷ٳԼƬרó򣨺ӽƬ
+        if (renderer.tileClassify)
+        {
+            TileClassifier& tiles = renderer.tiles;
+            fragment = injectShaderDefines(fragmentSource, qualityDefines + "#define TILE_PREPASS\n");
+            tiles.prepass[i] = createBlackholeProgram(vertexSource, fragment.c_str());
+            fragment = injectShaderDefines(fragmentSource, qualityDefines + defines + "#define TILE_BACKGROUND\n");
+            tiles.background[i] = createBlackholeProgram(vertexSource, fragment.c_str());
+            fragment = injectShaderDefines(fragmentSource, qualityDefines + defines + "#define TILE_DISK\n");
+            tiles.disk[i] = createBlackholeProgram(vertexSource, fragment.c_str());
+            if (tiles.prepass[i].program == 0 || tiles.background[i].program == 0 || tiles.disk[i].program == 0)
+            {
+                deleteBlackholeRenderer(renderer);
+                return false;
+            }
+        }
+    }
+    setBlackholeQuality(renderer, config.quality);
+
+    if (renderer.taa && !createTemporalAA(renderer.temporal, vertexSource, fragmentSource))
+    {
+        renderer.taa = false;
+        deleteBlackholeRenderer(renderer);
+        return false;
+    }
+
+    if (renderer.accumulate && !createAccumulation(renderer.accumulation, vertexSource, fragmentSource))
+    {
+        renderer.accumulate = false;
+        deleteBlackholeRenderer(renderer);
+        return false;
+    }
+
+    if (renderer.tileClassify && !createTileClassifier(renderer.tiles, vertexSource, fragmentSource))
+    {
+        deleteBlackholeRenderer(renderer);
+        return false;
+    }
+
+    //  pass Ҫʹͬıѡ
+    if (renderer.adaptive && !createAdaptiveRefine(renderer.refine, config.adaptiveBlock, config.adaptiveThreshold,
+        vertexSource, injectShaderDefines(fragmentSource, config.backgroundCubemap > 0 ? "#define BACKGROUND_CUBEMAP\n" : "").c_str()))
+    {
+        deleteBlackholeRenderer(renderer);
+        return false;
+    }
+
+    for (int i = 0; i < ShaderQualityCount && renderer.lensingLut; i++)
+    {
+        const ShaderQualityPreset& preset = shaderQualityPreset(static_cast<ShaderQuality>(i));
+        if (renderer.qualities[i].program != 0 &&
+            !createLensingLut(renderer.luts[i], BlackholeSize, preset.diskIterations, preset.bendSteps))
+        {
+            deleteBlackholeRenderer(renderer);
+            return false;
+        }
+    }
+
+    if (renderer.multiView && !createMultiView(renderer.views))
+    {
+        renderer.multiView = false;
+        deleteBlackholeRenderer(renderer);
+        return false;
+    }
+
+    renderer.quad = createFullscreenQuad();
+    //  dummy ޸ iChannel0 δ⣩ϣʱ iChannel0 Ϊϣ決 pass ͬҪ
+    renderer.dummyTex = renderer.noiseHash == NoiseHash::Texture ? createNoiseHashTexture() : createDummyTexture();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, renderer.dummyTex);
+
+    renderer.backgroundCubemap = config.backgroundCubemap > 0;
+    if (renderer.backgroundCubemap &&
+        !createBackgroundCubemap(renderer.background, config.backgroundCubemap, vertexSource, fragmentSource, renderer.quad))
+    {
+        renderer.backgroundCubemap = false;
+        deleteBlackholeRenderer(renderer);
+        return false;
+    }
+
+    renderer.diskNoiseTexture = config.diskNoiseTexture;
+    if (renderer.diskNoiseTexture && !createDiskNoise(renderer.diskNoise, vertexSource, fragmentSource, renderer.quad))
+    {
+        renderer.diskNoiseTexture = false;
+        deleteBlackholeRenderer(renderer);
+        return false;
+    }
+
+    // 룩ӳƻأĶԱ
+    ProgramCacheStats after = programCacheStats();
+    std::cout << "Ⱦʼʱ " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+        << " msɫ򣺻 " << after.loaded - before.loaded << "  " << after.loadMs - before.loadMs
+        << " ms " << after.compiled - before.compiled << "  " << after.compileMs - before.compileMs << " ms" << std::endl;
+    return true;
+}
+
+void deleteBlackholeRenderer(BlackholeRenderer& renderer)
+{
+    deleteFullscreenQuad(renderer.quad);
+    for (int i = 0; i < ShaderQualityCount; i++)
+        deleteBlackholeProgram(renderer.qualities[i]);
+    glDeleteTextures(1, &renderer.dummyTex);
+    if (renderer.lensingLut)
+    {
+        for (int i = 0; i < ShaderQualityCount; i++)
+            deleteLensingLut(renderer.luts[i]);
+    }
+    if (renderer.backgroundCubemap)
+        deleteBackgroundCubemap(renderer.background);
+    if (renderer.diskNoiseTexture)
+        deleteDiskNoise(renderer.diskNoise);
+    if (renderer.geodesicCache)
+        deleteGeodesicCache(renderer.geodesic);
+    if (renderer.taa)
+        deleteTemporalAA(renderer.temporal);
+    if (renderer.adaptive)
+        deleteAdaptiveRefine(renderer.refine);
+    if (renderer.tileClassify)
+        deleteTileClassifier(renderer.tiles);
+    if (renderer.countSteps)
+        deleteStepCounter(renderer.steps);
+    if (renderer.accumulate)
+        deleteAccumulation(renderer.accumulation);
+    if (renderer.multiView)
+        deleteMultiView(renderer.views);
+    renderer = BlackholeRenderer();
+}
+
+bool setBlackholeQuality(BlackholeRenderer& renderer, ShaderQuality quality)
+{
+    const BlackholeProgram& bh = renderer.qualities[static_cast<int>(quality)];
+    if (bh.program == 0)
+        return false;
+    renderer.bh = bh;
+    renderer.quality = quality;
+    return true;
+}
+
+void setBlackholeRegion(BlackholeRenderer& renderer, int x, int y, int width, int height)
+{
+    renderer.regionX = x;
+    renderer.regionY = y;
+    renderer.regionWidth = width;
+    renderer.regionHeight = height;
+    if (renderer.accumulate)
+        resetAccumulation(renderer.accumulation);
+}
+
+//  program õԤ決iChannel0͸ұͼ
+static void bindBlackholeResources(const BlackholeRenderer& renderer, unsigned int program, float resX)
+{
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, renderer.dummyTex);
+    if (renderer.lensingLut)
+        bindLensingLut(renderer.luts[static_cast<int>(renderer.quality)], program, LensSummaryUnit, LensPathUnit);
+    if (renderer.backgroundCubemap)
+        bindBackgroundCubemap(renderer.background, program, BackgroundUnit, resX);
+    if (renderer.diskNoiseTexture)
+        bindDiskNoise(renderer.diskNoise, program, DiskNoiseUnit);
+}
+
+void drawBlackhole(BlackholeRenderer& renderer, float time, float resX, float resY, float mouseX, float mouseY)
+{
+    if (renderer.geodesicCache && !updateGeodesicCache(renderer.geodesic, renderer.quality, renderer.quad,
+        static_cast<int>(resX), static_cast<int>(resY), mouseX, mouseY))
+        return;
+
+    // ʱ俹ݣȾԼĿ꣬ߵ֡
+    int outputFbo = 0;
+    int outputViewport[4];
+    if (renderer.taa)
+    {
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &outputFbo);
+        glGetIntegerv(GL_VIEWPORT, outputViewport);
+        if (!beginTemporalAA(renderer.temporal, static_cast<int>(resX), static_cast<int>(resY)))
+            return;
+    }
+
+    // Ƭࣺ׷ -> Ƭдģ -> ÿøԵĳ
+    if (renderer.tileClassify)
+    {
+        TileClassifier& tiles = renderer.tiles;
+        if (!beginTileClassify(tiles, renderer.quality, static_cast<int>(resX), static_cast<int>(resY), time, mouseX, mouseY))
+            return;
+        drawFullscreenQuad(renderer.quad);
+        classifyTiles(tiles, renderer.quad);
+        for (int tileClass = 0; tileClass < TileClassCount; tileClass++)
+        {
+            const BlackholeProgram& bh = beginTileClass(tiles, renderer.quality, tileClass, renderer.bh);
+            useBlackholeProgram(bh, time, resX, resY, mouseX, mouseY);
+            bindBlackholeResources(renderer, bh.program, resX);
+            drawFullscreenQuad(renderer.quad);
+        }
+        endTileClassify(tiles);
+        return;
+    }
+
+    // Ӧϸֲ -> ƽֵ -> ׷ģ²
+    if (renderer.adaptive)
+    {
+        AdaptiveRefine& refine = renderer.refine;
+        if (!beginAdaptiveRefine(refine, renderer.quality, static_cast<int>(resX), static_cast<int>(resY), time, mouseX, mouseY))
+            return;
+        bindBlackholeResources(renderer, refine.coarse[static_cast<int>(renderer.quality)].program, resX);
+        drawFullscreenQuad(renderer.quad);
+
+        beginAdaptiveClassify(refine, time, mouseX, mouseY, AdaptiveUnit);
+        bindBlackholeResources(renderer, refine.classify.program, resX);
+        drawFullscreenQuad(renderer.quad);
+        beginAdaptiveTrace(refine);
+    }
+
+    // ۻ֡ӵۻ壬ٰƽֵߵ֡
+    if (renderer.accumulate && !beginAccumulation(renderer.accumulation,
+        renderer.region ? renderer.regionWidth : static_cast<int>(resX),
+        renderer.region ? renderer.regionHeight : static_cast<int>(resY), time, mouseX, mouseY))
+        return;
+
+    if (renderer.countSteps && !beginStepCounter(renderer.steps, static_cast<int>(resX), static_cast<int>(resY)))
+        return;
+
+    useBlackholeProgram(renderer.bh, time, resX, resY, mouseX, mouseY);
+    bindBlackholeResources(renderer, renderer.bh.program, resX);
+    if (renderer.geodesicCache)
+        bindGeodesicCache(renderer.geodesic, renderer.bh.program, GeodesicUnit);
+    if (renderer.taa)
+    {
+        float jitterX, jitterY;
+        temporalAAJitter(renderer.temporal, jitterX, jitterY);
+        glUniform2f(glGetUniformLocation(renderer.bh.program, "iJitter"), jitterX, jitterY);
+    }
+    if (renderer.region)
+    {
+        glUniform2f(glGetUniformLocation(renderer.bh.program, "iRegionOffset"),
+            static_cast<float>(renderer.regionX), static_cast<float>(renderer.regionY));
+    }
+    if (renderer.accumulate)
+    {
+        float jitterX, jitterY;
+        accumulationJitter(renderer.accumulation, jitterX, jitterY);
+        glUniform2f(glGetUniformLocation(renderer.bh.program, "iJitter"), jitterX, jitterY);
+    }
+
+    drawFullscreenQuad(renderer.quad);
+
+    if (renderer.taa)
+        resolveTemporalAA(renderer.temporal, renderer.quad, time, mouseX, mouseY, outputFbo, outputViewport);
+    if (renderer.adaptive)
+        endAdaptiveRefine(renderer.refine);
+    if (renderer.countSteps)
+        endStepCounter(renderer.steps);
+    if (renderer.accumulate)
+        resolveAccumulation(renderer.accumulation, renderer.quad);
+}
+
+void drawBlackholeViews(BlackholeRenderer& renderer, const BlackholeView* views, int count, int columns, float resX, float resY)
+{
+    if (!renderer.multiView || count <= 0 || count > MaxViews)
+        return;
+    int rows = (count + columns - 1) / columns;
+    // iTimeiMouse  uniform 鰴ͼṩֻù iResolution
+    useBlackholeProgram(renderer.bh, 0.0f, resX, resY, 0.0f, 0.0f);
+    bindBlackholeResources(renderer, renderer.bh.program, resX);
+    bindMultiView(renderer.views, renderer.bh.program, views, count, columns, rows);
+    drawMultiView(renderer.quad, count);
+}
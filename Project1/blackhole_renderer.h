@@ -0,0 +1,74 @@
+#pragma once
+#include "render_config.h"
+#include "blackhole_pass.h"
+#include "fullscreen_quad.h"
+#include "lensing_lut.h"
+#include "background_cubemap.h"
+#include "disk_noise.h"
+#include "shader_quality.h"
+#include "geodesic_cache.h"
+#include "temporal_aa.h"
+#include "adaptive_refine.h"
+#include "tile_classify.h"
+#include "step_counter.h"
+#include "noise_hash.h"
+#include "accumulation.h"
+#include "multi_view.h"
+
+// һλỰȾڶ GL ԴɫȫıκԤ決
+struct BlackholeRenderer
+{
+    BlackholeProgram bh;        // ǰʵĳqualities еһ
+    BlackholeProgram qualities[ShaderQualityCount]; // ԤȱĻʱ壬δ program Ϊ 0
+    ShaderQuality quality = ShaderQuality::High;
+    FullscreenQuad quad;
+    unsigned int dummyTex = 0;      // iChannel01x1 ɫϣΪ Texture ʱǹϣ
+    NoiseHash noiseHash = NoiseHash::Sin;
+    bool lensingLut = false;    // ʹ͸ұѭ
+    LensingLut luts[ShaderQualityCount];    // ÿѱĻһţõһ
+    bool backgroundCubemap = false; // ݹ߲Ԥ決ıͼ
+    BackgroundCubemap background;
+    bool diskNoiseTexture = false;  // raymarchDisk Ԥ決
+    DiskNoise diskNoise;
+    bool geodesicCache = false;     // ʱò G-bufferֻɫ
+    GeodesicCache geodesic;
+    bool taa = false;               // ʱ俹ݴ AA 
+    TemporalAA temporal;
+    bool adaptive = false;          // ֲӦֱʣֻԲƽĿ׷
+    AdaptiveRefine refine;
+    bool tileClassify = false;      // Ƭͷרó
+    TileClassifier tiles;
+    bool countSteps = false;        // ͳÿ֡ƽֲ
+    StepCounter steps;
+    bool accumulate = false;        // ۻÿλƼһǰƽֵ
+    Accumulation accumulation;
+    bool region = false;            // ֿȾÿֻͼеһ
+    int regionX = 0;                // ǰͼеλúͳߴ磨أ
+    int regionY = 0;
+    int regionWidth = 0;
+    int regionHeight = 0;
+    bool multiView = false;         // Ϊͼ壬 drawBlackholeViews һλͼ
+    MultiView views;
+};
+
+//  config еѡעꡢ򲢺決ԴҪǰ GL ģ
+// config.allQualities Ϊ true ʱȫʱ壬ֻ config.quality
+bool createBlackholeRenderer(BlackholeRenderer& renderer, const RenderConfig& config,
+    const char* vertexSource, const char* fragmentSource);
+void deleteBlackholeRenderer(BlackholeRenderer& renderer);
+
+// лԤȱĻʱ壨ֻ򣬲±룩õδʱ false
+bool setBlackholeQuality(BlackholeRenderer& renderer, ShaderQuality quality);
+
+// ֿȾconfig.stillTile > 0֮ drawBlackhole ֻͼ½ (x, y)width x height һ飬
+// ߰ӿΪһĴСresX/resY Դͼĳߴ硣лֿ¿ʼۻ
+void setBlackholeRegion(BlackholeRenderer& renderer, int x, int y, int width, int height);
+
+// Ƶǰ󶨵֡壨ӿɵãmouseX/mouseY Ϊꡣ
+// ʹò߻ʱı֡ؽ G-buffer
+void drawBlackhole(BlackholeRenderer& renderer, float time, float resX, float resY, float mouseX, float mouseY);
+
+// ͼconfig.views > 0һʵư count ͼȾǰ֡壬߰ӿΪͼ
+// columns СresX x resY һ񣩣ͼ i ڵ i % columns С i / columns У¶ϣ
+// ÿĽӿΪ resX x resY ʱͬ drawBlackhole һ
+void drawBlackholeViews(BlackholeRenderer& renderer, const BlackholeView* views, int count, int columns, float resX, float resY);
@@ -0,0 +1,256 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <iostream>
+#include <vector>
+#include "cpu_backend.h"
+#include "cpu_renderer.h"
+#include "task_scheduler.h"
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+#include "image_write.h"
+
+// CPU  GLSL ݲ8 λͨ
+// hash()  fract(sin(x)*152754.742)sin  1 ulp ᱻŴͬ
+// ͬ GPU ֮ͬˣ԰ԭԱֻͳƣжáϣԱȣ
+// ߵ 152754.742  1.7ʱֻȡڻ/ɫ߼
+static const char* ShaderHashScale = "152754.742";
+static const char* LowGainHashScale = "1.7";
+static const double CompareMeanTolerance = 0.05;    // ƽ
+static const int ComparePixelTolerance = 8;         // صֵͨ
+static const double CompareOutlierFraction = 0.001; // ֵر
+
+struct ImageDiff
+{
+    double mean = 0.0;
+    int maxDiff = 0;
+    double outlierFraction = 0.0;
+};
+
+static CpuFrameParams frameParams(const RenderConfig& config, int frame)
+{
+    CpuFrameParams params;
+    params.time = config.startTime + frame * config.timeStep;
+    params.mouseX = config.mouseX * config.width;
+    params.mouseY = config.mouseY * config.height;
+    return params;
+}
+
+static int resolveThreads(int threads)
+{
+    return threads > 0 ? threads : hardwareThreadCount();
+}
+
+// ʵλ AA_Steps ѭ shaderQualityDefines ע GLSL ĺͬ
+static CpuShaderParams shaderParams(const RenderConfig& config)
+{
+    const ShaderQualityPreset& preset = shaderQualityPreset(config.quality);
+    CpuShaderParams shader;
+    shader.aa = preset.aa;
+    shader.steps = preset.steps;
+    shader.diskIterations = preset.diskIterations;
+    shader.bendSteps = preset.bendSteps;
+    return shader;
+}
+
+// CPU ںֲֻĬϵѭ sin ϣɫѡʾ
+static void reportIgnoredOptions(const RenderConfig& config)
+{
+    std::vector<const char*> ignored;
+    if (config.lensingLut)
+        ignored.push_back("--lensing-lut");
+    if (config.taa)
+        ignored.push_back("--taa");
+    if (config.geodesicCache)
+        ignored.push_back("--geodesic-cache");
+    if (config.adaptiveBlock > 0)
+        ignored.push_back("--adaptive");
+    if (config.analyticCrossing)
+        ignored.push_back("--analytic-crossing");
+    if (config.rk45)
+        ignored.push_back("--rk45");
+    if (config.weakField)
+        ignored.push_back("--weak-field");
+    if (config.countSteps)
+        ignored.push_back("--count-steps");
+    if (config.tileClassify)
+        ignored.push_back("--tile-classify");
+    if (config.diskNoiseTexture)
+        ignored.push_back("--disk-noise-texture");
+    if (config.noiseHash != NoiseHash::Sin)
+        ignored.push_back("--noise-hash");
+    if (config.backgroundCubemap > 0)
+        ignored.push_back("--background-cubemap");
+    for (const char* option : ignored)
+        std::cout << "CPU ȾֻʵĬϵ׷٣ " << option << std::endl;
+}
+
+int runCpuRender(const RenderConfig& config)
+{
+    reportIgnoredOptions(config);
+    CpuShaderParams shader = shaderParams(config);
+    int threads = resolveThreads(config.threads);
+    std::vector<unsigned char> pixels(static_cast<size_t>(config.width) * config.height * 3);
+
+    std::cout << "CPU Ⱦ" << cpuSimdBackendName() << "" << cpuSimdLanes() << " ·"
+        << threads << " ̣߳ " << shaderQualityPreset(config.quality).name << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < config.frames; frame++)
+    {
+        renderBlackholeCPU(shader, frameParams(config, frame), config.width, config.height, pixels.data(), threads);
+        std::string path = formatFramePath(config.output, frame);
+        if (!writeImagePPM(path, config.width, config.height, pixels.data(), false))
+            return -1;
+        std::cout << "д룺" << path << std::endl;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << config.frames << " ֡ʱ " << seconds << " s"
+        << config.frames / seconds << " ֡/s" << std::endl;
+    return 0;
+}
+
+int runCpuBenchmark(const RenderConfig& config)
+{
+    reportIgnoredOptions(config);
+    CpuShaderParams shader = shaderParams(config);
+    int maxThreads = resolveThreads(config.threads);
+    std::vector<unsigned char> pixels(static_cast<size_t>(config.width) * config.height * 3);
+    double pixelsPerFrame = static_cast<double>(config.width) * config.height;
+
+    std::cout << "CPU ²ԣ" << config.width << "x" << config.height << "" << config.frames << " ֡"
+        << cpuSimdBackendName() << "" << cpuSimdLanes() << " · " << shaderQualityPreset(config.quality).name << std::endl;
+
+    // Ԥһ֡ҳ䡢棩
+    renderBlackholeCPU(shader, frameParams(config, 0), config.width, config.height, pixels.data(), maxThreads);
+
+    double singleThread = 0.0;
+    for (int threads = 1; ; threads = std::min(threads * 2, maxThreads))
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < config.frames; frame++)
+            renderBlackholeCPU(shader, frameParams(config, frame), config.width, config.height, pixels.data(), threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double mpixels = pixelsPerFrame * config.frames / seconds / 1e6;
+        if (threads == 1)
+            singleThread = mpixels;
+        std::cout << "߳ " << threads << "" << mpixels << " Mpixels/sٱ "
+            << mpixels / singleThread << "x" << std::endl;
+
+        if (threads == maxThreads)
+            break;
+    }
+    return 0;
+}
+
+//  EGL Ⱦһ֡ GLSL οͼglReadPixels ¶ϣ
+// ֻȡʵλѡĬϣ CPU ںʵֵɫһ
+static bool renderGLReference(const RenderConfig& config, const CpuFrameParams& params,
+    const char* vertexSource, const char* fragmentSource, std::vector<unsigned char>& pixels)
+{
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return false;
+    BlackholeRenderer renderer;
+    RenderTarget target;
+    RenderConfig reference;
+    reference.quality = config.quality;
+    bool ok = createBlackholeRenderer(renderer, reference, vertexSource, fragmentSource);
+    if (ok && createRenderTarget(target, config.width, config.height, GL_RGBA8))
+    {
+        bindRenderTarget(target);
+        drawBlackhole(renderer, params.time, static_cast<float>(config.width), static_cast<float>(config.height), params.mouseX, params.mouseY);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, config.width, config.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        deleteRenderTarget(target);
+    }
+    else
+        ok = false;
+    deleteBlackholeRenderer(renderer);
+    destroyOffscreenContext(ctx);
+    return ok;
+}
+
+// gpu Ϊ¶cpu Ϊ϶
+static ImageDiff compareImages(const std::vector<unsigned char>& gpu, const std::vector<unsigned char>& cpu, int width, int height)
+{
+    ImageDiff diff;
+    double sum = 0.0;
+    size_t outliers = 0;
+    size_t rowSize = static_cast<size_t>(width) * 3;
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char* g = gpu.data() + (height - 1 - y) * rowSize;
+        const unsigned char* c = cpu.data() + y * rowSize;
+        for (int x = 0; x < width; x++)
+        {
+            int pixelMax = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                int d = std::abs(static_cast<int>(g[x * 3 + k]) - static_cast<int>(c[x * 3 + k]));
+                sum += d;
+                pixelMax = std::max(pixelMax, d);
+            }
+            diff.maxDiff = std::max(diff.maxDiff, pixelMax);
+            if (pixelMax > ComparePixelTolerance)
+                outliers++;
+        }
+    }
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    diff.mean = sum / (pixelCount * 3);
+    diff.outlierFraction = static_cast<double>(outliers) / pixelCount;
+    return diff;
+}
+
+static void printDiff(const char* title, const ImageDiff& diff)
+{
+    std::cout << title << "ƽ " << diff.mean << " / 255 " << diff.maxDiff
+        << " / 255 > " << ComparePixelTolerance << "  " << diff.outlierFraction * 100.0 << "%" << std::endl;
+}
+
+int runCpuCompare(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    size_t pixelCount = static_cast<size_t>(config.width) * config.height;
+    std::vector<unsigned char> gpuPixels(pixelCount * 3);
+    std::vector<unsigned char> cpuPixels(pixelCount * 3);
+    CpuFrameParams params = frameParams(config, 0);
+    int threads = resolveThreads(config.threads);
+
+    reportIgnoredOptions(config);
+    std::cout << "CPU  GLSL Աȣ" << config.width << "x" << config.height << "iTime=" << params.time
+        << " " << shaderQualityPreset(config.quality).name << "" << std::endl;
+
+    // 1. ԭԱȣͳƣ
+    CpuShaderParams shader = shaderParams(config);
+    if (!renderGLReference(config, params, vertexSource, fragmentSource, gpuPixels))
+        return -1;
+    renderBlackholeCPU(shader, params, config.width, config.height, cpuPixels.data(), threads);
+    printDiff("ԭ", compareImages(gpuPixels, cpuPixels, config.width, config.height));
+    writeImagePPM(formatFramePath(config.output, 0), config.width, config.height, cpuPixels.data(), false);
+
+    // 2. ϣԱȣж
+    std::string lowGainSource = fragmentSource;
+    size_t at = lowGainSource.find(ShaderHashScale);
+    if (at == std::string::npos)
+    {
+        std::cout << "ɫҲϣ " << ShaderHashScale << "޷Ա" << std::endl;
+        return 1;
+    }
+    lowGainSource.replace(at, strlen(ShaderHashScale), LowGainHashScale);
+    shader.hashScale = std::stof(LowGainHashScale);
+    if (!renderGLReference(config, params, vertexSource, lowGainSource.c_str(), gpuPixels))
+        return -1;
+    renderBlackholeCPU(shader, params, config.width, config.height, cpuPixels.data(), threads);
+    ImageDiff diff = compareImages(gpuPixels, cpuPixels, config.width, config.height);
+    printDiff("ϣ", diff);
+
+    bool pass = diff.mean <= CompareMeanTolerance && diff.outlierFraction <= CompareOutlierFraction;
+    std::cout << (pass ? "ͨ" : "ݲ") << "ݲƽ <= " << CompareMeanTolerance
+        << " > " << ComparePixelTolerance << "  <= " << CompareOutlierFraction * 100.0 << "%" << std::endl;
+    return pass ? 0 : 1;
+}
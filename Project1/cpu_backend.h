@@ -0,0 +1,11 @@
+#pragma once
+#include "render_config.h"
+
+// --cpu CPU Ⱦ config.frames ֡дļ
+int runCpuRender(const RenderConfig& config);
+
+// --cpu-bench 1, 2, 4, ... ̷ֱ߳Ⱦ Mpixels/s
+int runCpuBenchmark(const RenderConfig& config);
+
+// --cpu-compareGLSLEGL  CPU Ⱦһ֡Ƚϣݲʱط
+int runCpuCompare(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
@@ -0,0 +1,32 @@
+#pragma once
+// CPU ȾڲӿڣSIMD ں˰ָɶݣ cpu_kernel_simd.h cpu_renderer.cpp ʱѡ
+
+// ÿ֡һµӦɫֻ uniform ıʽ
+struct FrameUniforms
+{
+    float size, steps, speed;
+    int diskIterations, bendSteps; // ѭ / ڲ
+    float hashScale;
+    float time;
+    float resX, resY;
+    float camX, camY, camZ;     // תλ
+    float rayCosY, raySinY;     // Rotate(ray, angle) ĽǶ
+    float rayCosX, raySinX;
+    float rotCos, rotSin;       // raymarchDisk ת
+};
+
+// Ⱦ [x0, x1) x [y0, y1) أк϶£д width x height  RGB8 ͼ
+using CpuTileFunction = void (*)(const FrameUniforms& u, int aa, int x0, int y0, int x1, int y1, int height,
+    unsigned char* rgb, int width);
+
+struct CpuKernel
+{
+    CpuTileFunction renderTile = nullptr;
+    int lanes = 0;              // SIMD ͨ
+    const char* name = "";      // 
+};
+
+// ѡĻںˣx64 Ϊ SSE2ǿ
+CpuKernel cpuKernelBaseline();
+// AVX2 ںˣcpu_renderer_avx2.cpp x86 ƽ̨ renderTile Ϊ nullptrǰȷ CPU ֧ AVX2
+CpuKernel cpuKernelAvx2();
@@ -0,0 +1,334 @@
+#pragma once
+// CPU  blackhole.frag  SIMD ںˣFloatPack ĺɰǰıѡ
+// ÿָһԴļļһΣcpu_renderer.cpp Ϊߣcpu_renderer_avx2.cpp Ϊ AVX2
+// ʱ cpu_renderer.cpp  CPUID ѡĶ嶼ڲӣҲ std ģ壬
+// Խϸָĸϲߴ
+#include <math.h>
+#include "cpu_kernel.h"
+#include "simd_float.h"
+
+//  simd_float.h һռУָĸͻ
+namespace
+{
+struct Vec2P { FloatPack x, y; };
+struct Vec3P { FloatPack x, y, z; };
+struct Vec4P { FloatPack x, y, z, w; };
+}
+
+static inline FloatPack dot(const Vec3P& a, const Vec3P& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+static inline Vec3P operator*(FloatPack s, const Vec3P& v) { return { s * v.x, s * v.y, s * v.z }; }
+static inline Vec3P operator+(const Vec3P& a, const Vec3P& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+static inline Vec3P operator-(const Vec3P& a, const Vec3P& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+static inline Vec3P normalize(const Vec3P& v) { return (FloatPack(1.0f) / sqrt(dot(v, v))) * v; }
+static inline Vec3P blend(MaskPack m, const Vec3P& a, const Vec3P& b) { return { blend(m, a.x, b.x), blend(m, a.y, b.y), blend(m, a.z, b.z) }; }
+static inline Vec4P blend(MaskPack m, const Vec4P& a, const Vec4P& b) { return { blend(m, a.x, b.x), blend(m, a.y, b.y), blend(m, a.z, b.z), blend(m, a.w, b.w) }; }
+
+//  clamp  [0, 1] std::min/maxļͷ
+static inline float clampUnit(float x)
+{
+    return x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x);
+}
+
+// ϣ
+static inline FloatPack hash(FloatPack x, float k) { return fract(sin(x) * FloatPack(k)); }
+static inline FloatPack hash(FloatPack x, FloatPack y, float k) { return hash(x + hash(y, k), k); }
+
+// ֵ
+static inline FloatPack value(FloatPack px, FloatPack py, float f, float k)
+{
+    FloatPack fx = px * FloatPack(f), fy = py * FloatPack(f);
+    FloatPack bl = hash(floor(fx), floor(fy), k);
+    FloatPack br = hash(floor(fx + FloatPack(1.0f)), floor(fy), k);
+    FloatPack tl = hash(floor(fx), floor(fy + FloatPack(1.0f)), k);
+    FloatPack tr = hash(floor(fx + FloatPack(1.0f)), floor(fy + FloatPack(1.0f)), k);
+
+    FloatPack frx = fract(fx), fry = fract(fy);
+    frx = (FloatPack(3.0f) - FloatPack(2.0f) * frx) * frx * frx;
+    fry = (FloatPack(3.0f) - FloatPack(2.0f) * fry) * fry * fry;
+    FloatPack b = mix(bl, br, frx);
+    FloatPack t = mix(tl, tr, frx);
+    return mix(b, t, fry);
+}
+
+// ǿ+ƣ
+static Vec3P background(const FrameUniforms& u, const Vec3P& ray)
+{
+    MaskPack useX = FloatPack(0.5f) < abs(ray.x);
+    MaskPack useY = ~useX & (FloatPack(0.5f) < abs(ray.y));
+    FloatPack uvx = blend(useX, ray.z, ray.x);
+    FloatPack uvy = blend(useY, ray.z, ray.y);
+
+    // ǿ
+    FloatPack brightness = value(uvx * FloatPack(3.0f), uvy * FloatPack(3.0f), 100.0f, u.hashScale);
+    FloatPack color = value(uvx * FloatPack(2.0f), uvy * FloatPack(2.0f), 20.0f, u.hashScale);
+    for (int i = 0; i < 8; i++) // pow(brightness, 256.0)
+        brightness = brightness * brightness;
+    brightness = clamp(brightness * FloatPack(100.0f), FloatPack(0.0f), FloatPack(1.0f));
+
+    Vec3P stars = {
+        brightness * mix(FloatPack(1.0f), FloatPack(0.2f), color),
+        brightness * mix(FloatPack(0.6f), FloatPack(0.6f), color),
+        brightness * mix(FloatPack(0.2f), FloatPack(1.0f), color) };
+
+    // 
+    FloatPack nebula = value(uvx * FloatPack(1.5f), uvy * FloatPack(1.5f), 50.0f, u.hashScale) * FloatPack(0.2f);
+    nebula = nebula * nebula;
+    nebula = nebula * nebula; // pow(x, 4.0)
+    return { nebula + stars.x, nebula + stars.y, nebula + stars.z };
+}
+
+// ߲
+static Vec4P raymarchDisk(const FrameUniforms& u, const Vec3P& ray, const Vec3P& zeroPos)
+{
+    const float size = u.size, steps = u.steps;
+    Vec3P position = zeroPos;
+    FloatPack lengthPos = sqrt(position.x * position.x + position.z * position.z);
+    FloatPack dist = min(FloatPack(1.0f), lengthPos * FloatPack(1.0f / size * 0.5f)) * FloatPack(size * 0.4f * (1.0f / steps)) / abs(ray.y);
+
+    position = position + (dist * FloatPack(steps * 0.5f)) * ray;
+
+    FloatPack dpx = -zeroPos.z * FloatPack(0.01f) + zeroPos.x - zeroPos.x;
+    FloatPack dpy = zeroPos.x * FloatPack(0.01f) + zeroPos.z - zeroPos.z;
+    FloatPack invLen = FloatPack(1.0f) / sqrt(dpx * dpx + dpy * dpy);
+    dpx = dpx * invLen;
+    dpy = dpy * invLen;
+
+    FloatPack parallel = ray.x * dpx + ray.z * dpy;
+    parallel = parallel / sqrt(lengthPos) * FloatPack(0.5f);
+    FloatPack redShift = parallel + FloatPack(0.3f);
+    redShift = clamp(redShift * redShift, FloatPack(0.0f), FloatPack(1.0f));
+
+    FloatPack disMix = clamp((lengthPos - FloatPack(size * 2.0f)) * FloatPack(1.0f / size * 0.24f), FloatPack(0.0f), FloatPack(1.0f));
+    FloatPack redMix = redShift;
+    Vec3P insideCol = {
+        mix(FloatPack(1.0f), FloatPack(0.5f * 0.2f), disMix) * mix(FloatPack(0.4f), FloatPack(1.6f), redMix) * FloatPack(1.25f),
+        mix(FloatPack(0.8f), FloatPack(0.13f * 0.2f), disMix) * mix(FloatPack(0.2f), FloatPack(2.4f), redMix) * FloatPack(1.25f),
+        mix(FloatPack(0.0f), FloatPack(0.02f * 0.2f), disMix) * mix(FloatPack(0.1f), FloatPack(4.0f), redMix) * FloatPack(1.25f) };
+
+    Vec4P o = { FloatPack(0.0f), FloatPack(0.0f), FloatPack(0.0f), FloatPack(0.0f) };
+    const FloatPack zero(0.0f), one(1.0f);
+
+    for (float i = 0.0f; i < steps; i++)
+    {
+        position = position - dist * ray;
+
+        FloatPack intensity = clamp(FloatPack(1.0f - fabsf((i - 0.8f) * (1.0f / steps) * 2.0f)), zero, one);
+        FloatPack lengthPosI = sqrt(position.x * position.x + position.z * position.z);
+        FloatPack distMult = clamp((lengthPosI - FloatPack(size * 0.75f)) * FloatPack(1.0f / size * 1.5f), zero, one);
+        distMult = distMult * clamp((FloatPack(size * 10.0f) - lengthPosI) * FloatPack(1.0f / size * 0.20f), zero, one);
+        distMult = distMult * distMult;
+
+        FloatPack uu = lengthPosI + FloatPack(u.time * size * 0.3f) + intensity * FloatPack(size * 0.2f);
+
+        FloatPack xyx = -position.z * FloatPack(u.rotSin) + position.x * FloatPack(u.rotCos);
+        FloatPack xyy = position.x * FloatPack(u.rotSin) + position.z * FloatPack(u.rotCos);
+
+        FloatPack x = abs(xyx / xyy);
+        FloatPack angle = FloatPack(0.02f) * atanPositive(x);
+
+        const float f = 70.0f;
+        FloatPack noiseV = uu * FloatPack(1.0f / size * 0.05f);
+        FloatPack noise = value(angle, noiseV, f, u.hashScale);
+        noise = noise * FloatPack(0.66f) + FloatPack(0.33f) * value(angle, noiseV, f * 2.0f, u.hashScale);
+
+        float widthFalloff = 1.0f - clampUnit(i * (1.0f / steps) * 2.0f - 1.0f);
+        FloatPack extraWidth = noise * FloatPack(widthFalloff);
+        FloatPack alpha = clamp(noise * (intensity + extraWidth) * FloatPack((1.0f / size) * 10.0f + 0.01f) * dist * distMult, zero, one);
+
+        FloatPack colMix = min(one, intensity * FloatPack(2.0f));
+        Vec3P col = {
+            FloatPack(2.0f) * mix(FloatPack(0.3f) * insideCol.x, insideCol.x, colMix),
+            FloatPack(2.0f) * mix(FloatPack(0.2f) * insideCol.y, insideCol.y, colMix),
+            FloatPack(2.0f) * mix(FloatPack(0.15f) * insideCol.z, insideCol.z, colMix) };
+        FloatPack inv = one - alpha;
+        o.x = clamp(col.x * alpha + o.x * inv, zero, one);
+        o.y = clamp(col.y * alpha + o.y * inv, zero, one);
+        o.z = clamp(col.z * alpha + o.z * inv, zero, one);
+        o.w = clamp(o.w * inv + alpha, zero, one);
+
+        FloatPack lp = lengthPosI * FloatPack(1.0f / size);
+        FloatPack glow = redShift * (intensity + FloatPack(0.5f)) * FloatPack((1.0f / steps) * 100.0f) * distMult / (lp * lp);
+        o.x = o.x + glow;
+        o.y = o.y + glow;
+        o.z = o.z + glow;
+    }
+
+    o.x = clamp(o.x - FloatPack(0.005f), zero, one);
+    o.y = clamp(o.y - FloatPack(0.005f), zero, one);
+    o.z = clamp(o.z - FloatPack(0.005f), zero, one);
+    return o;
+}
+
+// Ӧɫ AA ѭ壬 outCol.rgb
+static Vec3P traceSample(const FrameUniforms& u, FloatPack dirX, FloatPack dirY)
+{
+    const float size = u.size;
+    const FloatPack zero(0.0f), one(1.0f);
+
+    // ߳ʼRotate(ray, angle)
+    Vec3P ray = normalize({ dirX, dirY, one });
+    FloatPack ry = FloatPack(u.rayCosY) * ray.y - FloatPack(u.raySinY) * ray.z;
+    FloatPack rz = FloatPack(u.rayCosY) * ray.z + FloatPack(u.raySinY) * ray.y;
+    ray.y = ry;
+    ray.z = rz;
+    FloatPack rx = FloatPack(u.rayCosX) * ray.x - FloatPack(u.raySinX) * ray.z;
+    rz = FloatPack(u.rayCosX) * ray.z + FloatPack(u.raySinX) * ray.x;
+    ray.x = rx;
+    ray.z = rz;
+
+    Vec3P pos = { FloatPack(u.camX), FloatPack(u.camY), FloatPack(u.camZ) };
+    Vec4P col = { zero, zero, zero, zero };
+    Vec4P glow = { zero, zero, zero, zero };
+    Vec3P outCol = { zero, zero, zero };
+    MaskPack done = noneMask();
+
+    // ߲ѭѽͨ㵫Σ
+    for (int disks = 0; disks < u.diskIterations; disks++)
+    {
+        for (int h = 0; h < u.bendSteps; h++)
+        {
+            FloatPack dotpos = dot(pos, pos);
+            FloatPack invDist = one / sqrt(dotpos);
+            FloatPack centDist = dotpos * invDist;
+            FloatPack stepDist = FloatPack(0.92f) * abs(pos.y / (ray.y + FloatPack(1e-6f)));
+            FloatPack farLimit = centDist * FloatPack(0.5f);
+            FloatPack closeLimit = centDist * FloatPack(0.1f) + FloatPack(0.05f) * centDist * centDist * FloatPack(1.0f / size);
+            stepDist = min(stepDist, min(farLimit, closeLimit));
+
+            FloatPack invDistSqr = invDist * invDist;
+            FloatPack bendForce = stepDist * invDistSqr * FloatPack(size * 0.625f);
+            ray = normalize(ray - (bendForce * invDist) * pos);
+            pos = pos + stepDist * ray;
+
+            FloatPack g = FloatPack(0.01f) * stepDist * invDistSqr * invDistSqr * clamp(centDist * FloatPack(2.0f) - FloatPack(1.2f), zero, one);
+            glow.x = glow.x + FloatPack(1.2f) * g;
+            glow.y = glow.y + FloatPack(1.1f) * g;
+            glow.z = glow.z + g;
+            glow.w = glow.w + g;
+        }
+
+        FloatPack dist2 = sqrt(dot(pos, pos));
+        FloatPack invA = one - col.w;
+
+        // ߱ڶ
+        MaskPack horizon = ~done & (dist2 < FloatPack(size * 0.1f));
+        if (any(horizon))
+        {
+            Vec3P c = { col.x * col.w + glow.x * invA, col.y * col.w + glow.y * invA, col.z * col.w + glow.z * invA };
+            outCol = blend(horizon, c, outCol);
+            done = done | horizon;
+        }
+
+        // ݵ
+        MaskPack escape = ~done & (FloatPack(size * 1000.0f) < dist2);
+        if (any(escape))
+        {
+            Vec3P bg = background(u, ray);
+            Vec3P c = {
+                col.x * col.w + bg.x * invA + glow.x * invA,
+                col.y * col.w + bg.y * invA + glow.y * invA,
+                col.z * col.w + bg.z * invA + glow.z * invA };
+            outCol = blend(escape, c, outCol);
+            done = done | escape;
+        }
+
+        // ߻
+        MaskPack disk = ~done & (abs(pos.y) <= FloatPack(size * 0.002f));
+        if (any(disk))
+        {
+            Vec4P diskCol = raymarchDisk(u, ray, pos);
+            Vec3P crossed = pos;
+            crossed.y = zero;
+            crossed = crossed + abs(FloatPack(size * 0.001f) / (ray.y + FloatPack(1e-6f))) * ray;
+            pos = blend(disk, crossed, pos);
+            FloatPack invDiskA = one - col.w;
+            Vec4P c = {
+                diskCol.x * invDiskA + col.x,
+                diskCol.y * invDiskA + col.y,
+                diskCol.z * invDiskA + col.z,
+                col.w + diskCol.w * invDiskA };
+            col = blend(disk, c, col);
+        }
+
+        if (all(done))
+            break;
+    }
+
+    // ѭδֹͨ
+    Vec3P rest = {
+        col.x + glow.x * (col.w + glow.w),
+        col.y + glow.y * (col.w + glow.w),
+        col.z + glow.z * (col.w + glow.w) };
+    return blend(done, outCol, rest);
+}
+
+static inline unsigned char toUnorm8(float c)
+{
+    // ٤У pow(col, 0.6)  GL 
+    c = powf(c > 0.0f ? c : 0.0f, 0.6f);
+    c = clampUnit(c);
+    return static_cast<unsigned char>(c * 255.0f + 0.5f);
+}
+
+static void renderKernelTile(const FrameUniforms& u, int aa, int x0, int y0, int x1, int y1, int height, unsigned char* rgb, int width)
+{
+    const int lanes = FloatPack::Lanes;
+    float laneOffsets[FloatPack::Lanes];
+    for (int i = 0; i < lanes; i++)
+        laneOffsets[i] = static_cast<float>(i);
+    const FloatPack laneX = FloatPack::load(laneOffsets);
+    const float invAA2 = 1.0f / static_cast<float>(aa * aa);
+
+    for (int row = y0; row < y1; row++)
+    {
+        // GL  fragCoord ԭ½ǣȡ
+        float fy = static_cast<float>(height - 1 - row) + 0.5f;
+        for (int x = x0; x < x1; x += lanes)
+        {
+            FloatPack fx = laneX + FloatPack(static_cast<float>(x) + 0.5f);
+            FloatPack rotX = fx * FloatPack(0.985f) + FloatPack(fy * 0.174f) + FloatPack(-0.06f * u.resX);
+            FloatPack rotY = FloatPack(fy * 0.985f) - fx * FloatPack(0.174f) + FloatPack(0.12f * u.resY);
+
+            Vec3P sum = { FloatPack(0.0f), FloatPack(0.0f), FloatPack(0.0f) };
+            for (int j = 0; j < aa; j++)
+            for (int i = 0; i < aa; i++)
+            {
+                FloatPack dirX = (rotX - FloatPack(u.resX * 0.5f) + FloatPack(static_cast<float>(i) / aa)) / FloatPack(u.resX);
+                FloatPack dirY = (rotY - FloatPack(u.resY * 0.5f) + FloatPack(static_cast<float>(j) / aa)) / FloatPack(u.resX);
+                Vec3P c = traceSample(u, dirX, dirY);
+                sum = sum + FloatPack(invAA2) * c;
+            }
+
+            float r[FloatPack::Lanes], g[FloatPack::Lanes], b[FloatPack::Lanes];
+            sum.x.store(r);
+            sum.y.store(g);
+            sum.z.store(b);
+            int count = x1 - x < lanes ? x1 - x : lanes;
+            unsigned char* dst = rgb + (static_cast<size_t>(row) * width + x) * 3;
+            for (int i = 0; i < count; i++)
+            {
+                dst[i * 3 + 0] = toUnorm8(r[i]);
+                dst[i * 3 + 1] = toUnorm8(g[i]);
+                dst[i * 3 + 2] = toUnorm8(b[i]);
+            }
+        }
+    }
+}
+
+// ں
+static CpuKernel makeCpuKernel()
+{
+    CpuKernel kernel;
+    kernel.renderTile = renderKernelTile;
+    kernel.lanes = FloatPack::Lanes;
+#if defined(SIMD_BACKEND_AVX512)
+    kernel.name = "AVX-512";
+#elif defined(SIMD_BACKEND_AVX2)
+    kernel.name = "AVX2";
+#elif defined(SIMD_BACKEND_SSE2)
+    kernel.name = "SSE2";
+#else
+    kernel.name = "";
+#endif
+    return kernel;
+}
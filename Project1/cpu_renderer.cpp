@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "cpu_renderer.h"
+#include "cpu_kernel_simd.h"
+#include "task_scheduler.h"
+
+// Ƭߴ磨Ϊ SIMD ͨ
+static const int TileWidth = 64;
+static const int TileHeight = 8;
+
+CpuKernel cpuKernelBaseline()
+{
+    return makeCpuKernel();
+}
+
+// CPU ϵͳǷ֧ AVX2 FMAMSVC  /arch:AVX2 ʱ FMA ָ
+static bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool fma = (info[2] & (1 << 12)) != 0;
+    // ϵͳҪ߳лʱ YMM Ĵ
+    if (!osxsave || !avx || !fma || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+// ںֻ֮ CPU ֧֡ͨʱ AVX2 ںˣ AVX-512 ʱѾ
+static CpuKernel chooseKernel()
+{
+    CpuKernel kernel = cpuKernelBaseline();
+    CpuKernel avx2 = cpuKernelAvx2();
+    if (avx2.renderTile && avx2.lanes > kernel.lanes && cpuSupportsAvx2())
+        kernel = avx2;
+    return kernel;
+}
+
+static const CpuKernel& selectedKernel()
+{
+    static const CpuKernel kernel = chooseKernel();
+    return kernel;
+}
+
+static FrameUniforms computeFrameUniforms(const CpuShaderParams& shader, const CpuFrameParams& frame, int width, int height)
+{
+    FrameUniforms u;
+    u.size = shader.size;
+    u.steps = shader.steps;
+    u.speed = shader.speed;
+    u.diskIterations = shader.diskIterations;
+    u.bendSteps = shader.bendSteps;
+    u.hashScale = shader.hashScale;
+    u.time = frame.time;
+    u.resX = static_cast<float>(width);
+    u.resY = static_cast<float>(height);
+
+    // λãvec3(0.0, 0.05, vec2) ֻȡ vec2  x 
+    float m = 20.0f * frame.mouseX / u.resY - 10.0f;
+    float px = 0.0f, py = 0.05f, pz = -m * m * 0.05f;
+    float angleX = frame.time * 0.1f;
+    float angleY = (2.0f * frame.mouseY / u.resY) * 3.14159f + 0.1f + 3.14159f;
+    float dist = std::sqrt(px * px + py * py + pz * pz);
+
+    // Rotate(pos, angle)
+    float c = std::cos(angleY), s = std::sin(angleY);
+    float ny = c * py - s * pz, nz = c * pz + s * py;
+    py = ny; pz = nz;
+    c = std::cos(angleX); s = std::sin(angleX);
+    float nx = c * px - s * pz;
+    nz = c * pz + s * px;
+    px = nx; pz = nz;
+    u.camX = px; u.camY = py; u.camZ = pz;
+
+    float bend = std::min(0.3f / dist, 3.14159f);
+    angleX -= bend;
+    angleY -= bend * 0.5f;
+    u.rayCosY = std::cos(angleY); u.raySinY = std::sin(angleY);
+    u.rayCosX = std::cos(angleX); u.raySinX = std::sin(angleX);
+
+    float rot = std::fmod(frame.time * shader.speed, 8192.0f);
+    u.rotCos = std::cos(rot);
+    u.rotSin = std::sin(rot);
+    return u;
+}
+
+void renderBlackholeCPU(const CpuShaderParams& shader, const CpuFrameParams& frame,
+    int width, int height, unsigned char* rgb, int threadCount)
+{
+    CpuTileFunction renderTile = selectedKernel().renderTile;
+    FrameUniforms u = computeFrameUniforms(shader, frame, width, height);
+    int tilesX = (width + TileWidth - 1) / TileWidth;
+    int tilesY = (height + TileHeight - 1) / TileHeight;
+
+    parallelForWorkStealing(tilesX * tilesY, threadCount, [&](int tile, int)
+    {
+        int x0 = (tile % tilesX) * TileWidth;
+        int y0 = (tile / tilesX) * TileHeight;
+        renderTile(u, shader.aa, x0, y0, std::min(x0 + TileWidth, width), std::min(y0 + TileHeight, height), height, rgb, width);
+    });
+}
+
+int cpuSimdLanes()
+{
+    return selectedKernel().lanes;
+}
+
+const char* cpuSimdBackendName()
+{
+    return selectedKernel().name;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+//  blackhole.frag 궨ӦĲ
+struct CpuShaderParams
+{
+    int aa = 1;             // AA
+    float speed = 3.0f;     // _Speed
+    float steps = 12.0f;    // _Steps
+    float size = 0.3f;      // _Size
+    int diskIterations = 20; // DISK_ITERATIONS
+    int bendSteps = 6;      // BEND_STEPS
+    float hashScale = 152754.742f; // hash()  fract(sin(x)*k)  k
+};
+
+// ɫ uniform Ӧ֡
+struct CpuFrameParams
+{
+    float time = 0.0f;      // iTime
+    float mouseX = 0.0f;    // iMouse꣩
+    float mouseY = 0.0f;
+};
+
+// CPU  blackhole.fragƬùȡȵ threadCount ̣߳
+// ÿ SIMD һڵء϶µ RGB8width*height*3 ֽڣ
+void renderBlackholeCPU(const CpuShaderParams& shader, const CpuFrameParams& frame,
+    int width, int height, unsigned char* rgb, int threadCount);
+
+// SIMD ͨ
+int cpuSimdLanes();
+const char* cpuSimdBackendName();
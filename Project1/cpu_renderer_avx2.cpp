@@ -0,0 +1,39 @@
+// CPU Ⱦ AVX2  cpu_renderer.cpp  cpu_kernel_simd.hֻʱ⵽ AVX2 ʱʹá
+// VS ֻԱļ /arch:AVX2g++/clang Ҫıѡ水 AVX2
+#include <math.h>
+#include "cpu_kernel.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+// ׼ͷļڿĿָ֮ǰеָֻ
+#include <cmath>
+#include <immintrin.h>
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#define SIMD_TARGET_AVX2 1
+#include "cpu_kernel_simd.h"
+
+CpuKernel cpuKernelAvx2()
+{
+    return makeCpuKernel();
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+
+CpuKernel cpuKernelAvx2()
+{
+    return CpuKernel();
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include <glad/glad.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "disk_noise.h"
+#include "program_cache.h"
+#include "shader_read.h"
+
+bool createDiskNoise(DiskNoise& noise, const char* vertexSource, const char* fragmentSource, const FullscreenQuad& quad)
+{
+    std::string fragment = injectShaderDefines(fragmentSource, "#define BAKE_DISK_NOISE\n");
+    unsigned int program = createCachedShaderProgram(vertexSource, fragment.c_str());
+    if (program == 0)
+        return false;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // 決 pass Ԫ 0 ϵ iChannel0ϣΪ texture ʱǹϣָԭİ
+    int previousTexture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+
+    // ֮Ӳ˫Բֵѭ
+    glGenTextures(1, &noise.tex);
+    glBindTexture(GL_TEXTURE_2D, noise.tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, DiskNoiseWidth, DiskNoiseHeight, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glBindTexture(GL_TEXTURE_2D, previousTexture);
+
+    int previousFbo = 0;
+    int previousViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    unsigned int fbo = 0;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, noise.tex, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (complete)
+    {
+        glViewport(0, 0, DiskNoiseWidth, DiskNoiseHeight);
+        glUseProgram(program);
+        drawFullscreenQuad(quad);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteProgram(program);
+    glFinish();
+
+    noise.bakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // 
+    if (!complete || glGetError() != GL_NO_ERROR)
+    {
+        std::cout << "決ʧܣ" << std::endl;
+        deleteDiskNoise(noise);
+        return false;
+    }
+    std::cout << "決ɣ" << DiskNoiseWidth << "x" << DiskNoiseHeight << "ʱ " << noise.bakeMs << " ms" << std::endl;
+    return true;
+}
+
+void deleteDiskNoise(DiskNoise& noise)
+{
+    glDeleteTextures(1, &noise.tex);
+    noise = DiskNoise();
+}
+
+void bindDiskNoise(const DiskNoise& noise, unsigned int program, int unit)
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, noise.tex);
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(glGetUniformLocation(program, "iDiskNoise"), unit);
+}
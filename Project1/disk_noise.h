@@ -0,0 +1,23 @@
+#pragma once
+#include "fullscreen_quad.h"
+
+// ĳߴ磨 = ֵĸ㣩raymarchDisk ĽǶ f = 140 ʱֻõ
+// 0 ~ 5 Ÿ㣻뾶 iTime ÿԼǰ 2 㣬4096 ԼСʱѭһ
+const int DiskNoiseWidth = 16;
+const int DiskNoiseHeight = 4096;
+
+// Ԥ決 DISK_NOISE_TEXTUREraymarchDisk ÿ value()
+// ÿ 4  sin  hashỰʼʱͬһ hash ѸֵȾѭ R32F 
+// ֮ÿ value() ΪһӲ˫ԲֵȨ꣩ѭ ALU һ
+struct DiskNoise
+{
+    unsigned int tex = 0;
+    double bakeMs = 0.0;
+};
+
+//  BAKE_DISK_NOISE ȾҪǰ GL ģָ֮ǰ󶨵֡ӿڣ
+bool createDiskNoise(DiskNoise& noise, const char* vertexSource, const char* fragmentSource, const FullscreenQuad& quad);
+void deleteDiskNoise(DiskNoise& noise);
+
+// 󶨵Ԫ unit program е iDiskNoise
+void bindDiskNoise(const DiskNoise& noise, unsigned int program, int unit);
@@ -0,0 +1,107 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "dynamic_resolution.h"
+#include "program_cache.h"
+#include "shader_read.h"
+
+// ֡仯 10%GPU ʱҪӳټ֡ܶأ
+static const float MaxScaleStep = 1.1f;
+// ʱƽȨ
+static const double SmoothFactor = 0.25;
+
+bool createDynamicResolution(DynamicResolution& dr, const RenderConfig& config,
+    int outputWidth, int outputHeight, const char* vertexSource)
+{
+    dr.targetMs = config.dynamicResolution;
+    dr.minScale = config.minScale;
+    dr.maxScale = config.maxScale;
+    dr.hysteresis = config.scaleHysteresis;
+    dr.sharpness = config.upscaleSharpness;
+    dr.scale = dr.maxScale;
+
+    std::string fragmentCode = readShaderFile("upscale.frag");
+    dr.upscaleProgram = createCachedShaderProgram(vertexSource, fragmentCode.c_str());
+    if (dr.upscaleProgram == 0)
+        return false;
+
+    if (!resizeDynamicResolution(dr, outputWidth, outputHeight))
+    {
+        glDeleteProgram(dr.upscaleProgram);
+        dr.upscaleProgram = 0;
+        return false;
+    }
+    return true;
+}
+
+void deleteDynamicResolution(DynamicResolution& dr)
+{
+    deleteRenderTarget(dr.target);
+    glDeleteProgram(dr.upscaleProgram);
+    dr = DynamicResolution();
+}
+
+bool resizeDynamicResolution(DynamicResolution& dr, int outputWidth, int outputHeight)
+{
+    if (dr.target.fbo != 0)
+        deleteRenderTarget(dr.target);
+
+    dr.outputWidth = outputWidth;
+    dr.outputHeight = outputHeight;
+    int width = std::max(1, static_cast<int>(std::ceil(outputWidth * dr.maxScale)));
+    int height = std::max(1, static_cast<int>(std::ceil(outputHeight * dr.maxScale)));
+    return createRenderTarget(dr.target, width, height, GL_RGBA8);
+}
+
+int dynamicRenderWidth(const DynamicResolution& dr)
+{
+    return std::min(dr.target.width, std::max(1, static_cast<int>(dr.outputWidth * dr.scale + 0.5f)));
+}
+
+int dynamicRenderHeight(const DynamicResolution& dr)
+{
+    return std::min(dr.target.height, std::max(1, static_cast<int>(dr.outputHeight * dr.scale + 0.5f)));
+}
+
+void bindDynamicResolution(const DynamicResolution& dr)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, dr.target.fbo);
+    glViewport(0, 0, dynamicRenderWidth(dr), dynamicRenderHeight(dr));
+}
+
+void drawDynamicUpscale(const DynamicResolution& dr, const FullscreenQuad& quad)
+{
+    glUseProgram(dr.upscaleProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, dr.target.colorTex);
+    glUniform1i(glGetUniformLocation(dr.upscaleProgram, "iSource"), 0);
+    glUniform2f(glGetUniformLocation(dr.upscaleProgram, "iSourceScale"),
+        static_cast<float>(dynamicRenderWidth(dr)) / dr.target.width,
+        static_cast<float>(dynamicRenderHeight(dr)) / dr.target.height);
+    glUniform1f(glGetUniformLocation(dr.upscaleProgram, "iSharpness"), dr.sharpness);
+    drawFullscreenQuad(quad);
+}
+
+bool updateDynamicResolution(DynamicResolution& dr, double frameMs)
+{
+    if (frameMs <= 0.0)
+        return false;
+    dr.smoothedMs = dr.smoothedMs > 0.0 ? dr.smoothedMs + (frameMs - dr.smoothedMs) * SmoothFactor : frameMs;
+
+    // ڲԤ㸽
+    if (std::abs(dr.smoothedMs - dr.targetMs) <= dr.targetMs * dr.hysteresis)
+        return false;
+
+    float desired = dr.scale * static_cast<float>(std::sqrt(dr.targetMs / dr.smoothedMs));
+    desired = std::min(std::max(desired, dr.scale / MaxScaleStep), dr.scale * MaxScaleStep);
+    desired = std::min(std::max(desired, dr.minScale), dr.maxScale);
+
+    int oldWidth = dynamicRenderWidth(dr);
+    int oldHeight = dynamicRenderHeight(dr);
+    // ±Ԥʱ򻬶ƽͺñͷ
+    dr.smoothedMs *= (desired / dr.scale) * (desired / dr.scale);
+    dr.scale = desired;
+    return dynamicRenderWidth(dr) != oldWidth || dynamicRenderHeight(dr) != oldHeight;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "render_config.h"
+#include "render_target.h"
+#include "fullscreen_quad.h"
+
+// ֱ̬ʣڶȾ FBO ½ scale ɷŴ pass Ŀֱʡ
+// FBO һη䣬ֻıӿں iResolution·
+// ÿ֡ݲõĺʱ scaleʱscale^2Ƴȣ
+// Ԥ +-hysteresis ʱ sqrt(Ŀ / ʵ) ֡仯Եӳ
+struct DynamicResolution
+{
+    RenderTarget target;
+    unsigned int upscaleProgram = 0;
+    int outputWidth = 0;        // Ŵֱ
+    int outputHeight = 0;
+    float scale = 1.0f;         // ǰȾÿᣩ
+    double smoothedMs = 0.0;    // ʱָƽ
+
+    float targetMs = 16.0f;
+    float minScale = 0.25f;
+    float maxScale = 1.0f;
+    float hysteresis = 0.1f;
+    float sharpness = 0.0f;
+};
+
+//  config еԤΧҪǰ GL ģupscale.frag ӹĿ¼ȡ
+bool createDynamicResolution(DynamicResolution& dr, const RenderConfig& config,
+    int outputWidth, int outputHeight, const char* vertexSource);
+void deleteDynamicResolution(DynamicResolution& dr);
+
+// ֱʸı䣨ţʱ· FBO
+bool resizeDynamicResolution(DynamicResolution& dr, int outputWidth, int outputHeight);
+
+// ǰµȾֱʣɫ iResolution
+int dynamicRenderWidth(const DynamicResolution& dr);
+int dynamicRenderHeight(const DynamicResolution& dr);
+
+//  FBO ӿΪǰȾֱ
+void bindDynamicResolution(const DynamicResolution& dr);
+// ѵͷֱʻŴƵǰ󶨵֡壨ӿɵã
+void drawDynamicUpscale(const DynamicResolution& dr, const FullscreenQuad& quad);
+
+// һ֡ʵʱmsһ֡ıرǷı
+bool updateDynamicResolution(DynamicResolution& dr, double frameMs);
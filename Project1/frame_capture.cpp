@@ -0,0 +1,135 @@
+#include <glad/glad.h>
+#include <chrono>
+#include <iostream>
+#include "frame_capture.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+bool createFrameCapture(FrameCapture& capture, int width, int height, int ringSize, const FrameConsumer& consumer)
+{
+    // 
+    if (ringSize < 1 || ringSize > FrameCaptureMaxRing)
+    {
+        std::cout << "ػ PBO  1 ~ " << FrameCaptureMaxRing << " ֮䣡" << std::endl;
+        return false;
+    }
+
+    capture.width = width;
+    capture.height = height;
+    capture.ringSize = ringSize;
+    capture.consumer = consumer;
+    glGenBuffers(ringSize, capture.pbos);
+    for (int i = 0; i < ringSize; i++)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pbos[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(width) * height * 3, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (glGetError() != GL_NO_ERROR)
+    {
+        std::cout << " PBO ʧܣ" << std::endl;
+        deleteFrameCapture(capture);
+        return false;
+    }
+    return true;
+}
+
+void deleteFrameCapture(FrameCapture& capture)
+{
+    for (int i = 0; i < capture.ringSize; i++)
+    {
+        if (capture.fences[i] != nullptr)
+            glDeleteSync(static_cast<GLsync>(capture.fences[i]));
+    }
+    glDeleteBuffers(capture.ringSize, capture.pbos);
+    capture = FrameCapture();
+}
+
+// ӳ index  PBOդɣ consumer ͷ
+static void deliverFrame(FrameCapture& capture, int index)
+{
+    auto start = Clock::now();
+    glDeleteSync(static_cast<GLsync>(capture.fences[index]));
+    capture.fences[index] = nullptr;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pbos[index]);
+    const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+        static_cast<GLsizeiptr>(capture.width) * capture.height * 3, GL_MAP_READ_BIT);
+    if (data != nullptr)
+    {
+        if (capture.consumer)
+            capture.consumer(capture.frames[index], static_cast<const unsigned char*>(data), capture.width, capture.height);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        capture.captured++;
+    }
+    else
+        std::cout << " PBO ӳʧܣ " << capture.frames[index] << " ֡" << std::endl;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    capture.mapMs += elapsedMs(start);
+}
+
+// ȴ index  PBO դһεȴʱˢУ֤դᱻύ
+static void waitFrame(FrameCapture& capture, int index)
+{
+    GLsync fence = static_cast<GLsync>(capture.fences[index]);
+    if (glClientWaitSync(fence, 0, 0) != GL_TIMEOUT_EXPIRED)
+        return;
+
+    capture.stalls++;
+    auto start = Clock::now();
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED)
+        ;
+    capture.waitMs += elapsedMs(start);
+}
+
+void captureFrame(FrameCapture& capture, long long frame)
+{
+    int index = capture.next;
+    if (capture.fences[index] != nullptr)
+    {
+        waitFrame(capture, index);
+        deliverFrame(capture, index);
+    }
+
+    auto start = Clock::now();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pbos[index]);
+    glReadPixels(0, 0, capture.width, capture.height, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    capture.fences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    capture.frames[index] = frame;
+    capture.next = (index + 1) % capture.ringSize;
+    capture.issueMs += elapsedMs(start);
+}
+
+void pollFrameCapture(FrameCapture& capture)
+{
+    // capture.next ɵһ֡
+    for (int n = 0; n < capture.ringSize; n++)
+    {
+        int index = (capture.next + n) % capture.ringSize;
+        if (capture.fences[index] == nullptr)
+            continue;
+        if (glClientWaitSync(static_cast<GLsync>(capture.fences[index]), 0, 0) == GL_TIMEOUT_EXPIRED)
+            break;
+        deliverFrame(capture, index);
+    }
+}
+
+void flushFrameCapture(FrameCapture& capture)
+{
+    for (int n = 0; n < capture.ringSize; n++)
+    {
+        int index = (capture.next + n) % capture.ringSize;
+        if (capture.fences[index] == nullptr)
+            continue;
+        waitFrame(capture, index);
+        deliverFrame(capture, index);
+    }
+}
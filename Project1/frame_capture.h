@@ -0,0 +1,42 @@
+#pragma once
+#include <functional>
+
+// ػ PBO 
+const int FrameCaptureMaxRing = 8;
+
+// ɶصһ֡RGB 8 λglReadPixels ¶ϣָֻڻصڼЧ
+using FrameConsumer = std::function<void(long long frame, const unsigned char* rgb, int width, int height)>;
+
+// 첽֡أglReadPixels д뻷еػGL_PIXEL_PACK_BUFFERأդ
+//  k ֡ʹõ k % ringSize  PBOȵ k + ringSize ֡Ҫʱŵȴդӳ䲢 consumer
+// ʱ GPU һ֡CPU ӳ k - N ֡ GPU Ⱦ k ֡صÿ֡ſչ
+struct FrameCapture
+{
+    int width = 0;
+    int height = 0;
+    int ringSize = 3;
+    unsigned int pbos[FrameCaptureMaxRing] = {};
+    void* fences[FrameCaptureMaxRing] = {};     // GLsync0 ʾ PBO 
+    long long frames[FrameCaptureMaxRing] = {}; // ÿ PBO е֡
+    int next = 0;
+    FrameConsumer consumer;
+
+    long long captured = 0;     // ѽ consumer ֡
+    long long stalls = 0;       //  PBO ʱդδɡҪȴ GPU Ĵ
+    double issueMs = 0.0;       // captureFrame зص CPU ʱ
+    double waitMs = 0.0;        // ȴդʱ
+    double mapMs = 0.0;         // ӳ䡢صӳʱ
+};
+
+// Ҫǰ GL ģringSize Ϊ 1 ~ FrameCaptureMaxRingʧʱ false
+bool createFrameCapture(FrameCapture& capture, int width, int height, int ringSize, const FrameConsumer& consumer);
+// δɵ֡Ҫʱȵ flushFrameCapture
+void deleteFrameCapture(FrameCapture& capture);
+
+// ӵǰ֡ (0, 0) 첽 width x heightΪ frame
+// һ PBO δ֡ʱȰ consumer
+void captureFrame(FrameCapture& capture, long long frame);
+// ֡˳򽻸դɵ֡δɵľͣ£ȴ GPU
+void pollFrameCapture(FrameCapture& capture);
+// ȴδɵ֡
+void flushFrameCapture(FrameCapture& capture);
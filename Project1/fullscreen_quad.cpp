@@ -0,0 +1,52 @@
+#include <glad/glad.h>
+#include "fullscreen_quad.h"
+
+FullscreenQuad createFullscreenQuad()
+{
+    // 
+    float quadVertices[] = {
+        // λ          // 
+        -1.0f,  1.0f,    0.0f, 1.0f, // 
+        -1.0f, -1.0f,    0.0f, 0.0f, // 
+        1.0f, -1.0f,    1.0f, 0.0f, // 
+        1.0f,  1.0f,    1.0f, 1.0f  // 
+    };
+    unsigned int indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    FullscreenQuad quad;
+    glGenVertexArrays(1, &quad.VAO);
+    glGenBuffers(1, &quad.VBO);
+    glGenBuffers(1, &quad.EBO);
+    // 
+    glBindVertexArray(quad.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, quad.VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+
+    // 壨ıΣ
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    // λԣlayout 0
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // ԣlayout 1
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    return quad;
+}
+
+void drawFullscreenQuad(const FullscreenQuad& quad)
+{
+    glBindVertexArray(quad.VAO);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+}
+
+void deleteFullscreenQuad(FullscreenQuad& quad)
+{
+    glDeleteVertexArrays(1, &quad.VAO);
+    glDeleteBuffers(1, &quad.VBO);
+    glDeleteBuffers(1, &quad.EBO);
+    quad = FullscreenQuad();
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// ȫıΣλ layout 0 layout 1
+struct FullscreenQuad
+{
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+};
+
+FullscreenQuad createFullscreenQuad();
+void drawFullscreenQuad(const FullscreenQuad& quad);
+void deleteFullscreenQuad(FullscreenQuad& quad);
@@ -0,0 +1,115 @@
+#include <glad/glad.h>
+#include <iostream>
+#include "geodesic_cache.h"
+
+// ݷڲƵǿգ 32 λࣨ潻㡢򡢻Թ⣩뾫㹻
+static const GLenum TextureFormats[GeodesicTextureCount] = {
+    GL_RGBA32F, GL_RGBA16F, GL_RGBA16F, GL_RGBA16F, GL_RGBA16F, GL_RGBA16F,
+};
+static const char* SamplerNames[GeodesicTextureCount] = {
+    "iGeodesic", "iGeodesicRayY", "iGeodesicCrossing0", "iGeodesicCrossing1", "iGeodesicCrossing2", "iGeodesicCrossing3",
+};
+
+static void deleteGBuffer(GeodesicCache& cache)
+{
+    glDeleteFramebuffers(1, &cache.fbo);
+    glDeleteTextures(GeodesicTextureCount, cache.textures);
+    cache.fbo = 0;
+    for (int i = 0; i < GeodesicTextureCount; i++)
+        cache.textures[i] = 0;
+    cache.width = 0;
+    cache.height = 0;
+    cache.valid = false;
+}
+
+static bool createGBuffer(GeodesicCache& cache, int width, int height)
+{
+    glGenTextures(GeodesicTextureCount, cache.textures);
+    GLenum drawBuffers[GeodesicTextureCount];
+    glGenFramebuffers(1, &cache.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, cache.fbo);
+    for (int i = 0; i < GeodesicTextureCount; i++)
+    {
+        //  texelFetch ȡҪ
+        glBindTexture(GL_TEXTURE_2D, cache.textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, TextureFormats[i], width, height, 0, GL_RGBA, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, cache.textures[i], 0);
+        drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+    }
+    glDrawBuffers(GeodesicTextureCount, drawBuffers);
+
+    cache.width = width;
+    cache.height = height;
+    // 
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "߻֡岻" << std::endl;
+        deleteGBuffer(cache);
+        return false;
+    }
+    return true;
+}
+
+void deleteGeodesicCache(GeodesicCache& cache)
+{
+    deleteGBuffer(cache);
+    for (int i = 0; i < ShaderQualityCount; i++)
+        deleteBlackholeProgram(cache.gbuffer[i]);
+    cache = GeodesicCache();
+}
+
+bool updateGeodesicCache(GeodesicCache& cache, ShaderQuality quality, const FullscreenQuad& quad,
+    int width, int height, float mouseX, float mouseY)
+{
+    if (cache.valid && cache.width == width && cache.height == height &&
+        cache.mouseX == mouseX && cache.mouseY == mouseY && cache.quality == quality)
+    {
+        cache.reuses++;
+        return true;
+    }
+
+    int previousFbo = 0;
+    int previousViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    bool ok = true;
+    if (cache.width != width || cache.height != height)
+    {
+        deleteGBuffer(cache);
+        ok = createGBuffer(cache, width, height);
+    }
+
+    if (ok)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, cache.fbo);
+        glViewport(0, 0, width, height);
+        // iTime ̶Ϊ 0ʱصתɫ pass в
+        useBlackholeProgram(cache.gbuffer[static_cast<int>(quality)], 0.0f,
+            static_cast<float>(width), static_cast<float>(height), mouseX, mouseY);
+        drawFullscreenQuad(quad);
+
+        cache.valid = true;
+        cache.mouseX = mouseX;
+        cache.mouseY = mouseY;
+        cache.quality = quality;
+        cache.rebuilds++;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    return ok;
+}
+
+void bindGeodesicCache(const GeodesicCache& cache, unsigned int program, int firstUnit)
+{
+    for (int i = 0; i < GeodesicTextureCount; i++)
+    {
+        glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+        glBindTexture(GL_TEXTURE_2D, cache.textures[i]);
+        glUniform1i(glGetUniformLocation(program, SamplerNames[i]), firstUnit + i);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
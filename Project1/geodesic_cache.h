@@ -0,0 +1,37 @@
+#pragma once
+#include "blackhole_pass.h"
+#include "fullscreen_quad.h"
+#include "shader_quality.h"
+
+// G-buffer ݷ+Թ⡢δԽ |ray.y|4 洩Խ
+const int GeodesicTextureCount = 6;
+
+// ߻棨--geodesic-cacheÿص߽/ݷ潻䷽򡢻Թ⣩
+//  G-bufferֻiMouseֱʡʣıʱؽÿֻ֡ɫ̺ͱ
+//  iTime  y תɫʱزϣ blackhole.frag  GEODESIC_GBUFFER ˵
+struct GeodesicCache
+{
+    unsigned int fbo = 0;
+    unsigned int textures[GeodesicTextureCount] = {};
+    int width = 0;
+    int height = 0;
+    BlackholeProgram gbuffer[ShaderQualityCount];   // ȾĻʱһһӦ
+
+    // Ӧ
+    bool valid = false;
+    float mouseX = 0.0f;
+    float mouseY = 0.0f;
+    ShaderQuality quality = ShaderQuality::High;
+
+    long long rebuilds = 0;     // ؽ
+    long long reuses = 0;       // ֱӸõ֡
+};
+
+void deleteGeodesicCache(GeodesicCache& cache);
+
+// 뻺治һʱ G-bufferָ֮ǰ󶨵֡ӿڣmouseX/mouseY Ϊ
+bool updateGeodesicCache(GeodesicCache& cache, ShaderQuality quality, const FullscreenQuad& quad,
+    int width, int height, float mouseX, float mouseY);
+
+//  G-buffer 󶨵 firstUnit Ԫɫе iGeodesic* 
+void bindGeodesicCache(const GeodesicCache& cache, unsigned int program, int firstUnit);
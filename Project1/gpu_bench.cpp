@@ -0,0 +1,306 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "gpu_bench.h"
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+#include "frame_capture.h"
+#include "parallel_render.h"
+#include "task_scheduler.h"
+
+// ɫ壺 + Ⱦ޸
+struct BenchVariant
+{
+    const char* name;
+    std::function<void(RenderConfig&)> apply;
+};
+
+static std::vector<BenchVariant> benchVariants()
+{
+    // δָ --background-cubemap ʱ 1024 決
+    auto cubemap = [](RenderConfig& c) { if (c.backgroundCubemap <= 0) c.backgroundCubemap = 1024; };
+    return {
+        { "ԭʼѭ", [](RenderConfig& c) { c.backgroundCubemap = 0; } },
+        { "ͻ", [](RenderConfig& c) { c.quality = ShaderQuality::Low; c.backgroundCubemap = 0; } },
+        { "л", [](RenderConfig& c) { c.quality = ShaderQuality::Medium; c.backgroundCubemap = 0; } },
+        { "߻", [](RenderConfig& c) { c.quality = ShaderQuality::Ultra; c.backgroundCubemap = 0; } },
+        { "潻", [](RenderConfig& c) { c.analyticCrossing = true; c.backgroundCubemap = 0; } },
+        { "Ӧ", [](RenderConfig& c) { c.rk45 = true; c.backgroundCubemap = 0; } },
+        { "", [](RenderConfig& c) { c.weakField = true; c.backgroundCubemap = 0; } },
+        { "ʱ俹", [](RenderConfig& c) { c.taa = true; c.backgroundCubemap = 0; } },
+        { "Ӧϸ 4x4", [](RenderConfig& c) { c.adaptiveBlock = 4; c.backgroundCubemap = 0; } },
+        { "Ӧϸ 2x2", [](RenderConfig& c) { c.adaptiveBlock = 2; c.backgroundCubemap = 0; } },
+        { "Ƭ", [](RenderConfig& c) { c.tileClassify = true; c.backgroundCubemap = 0; } },
+        { "߻棨ֹ", [](RenderConfig& c) { c.geodesicCache = true; c.backgroundCubemap = 0; } },
+        { "͸ұ", [](RenderConfig& c) { c.lensingLut = true; c.backgroundCubemap = 0; } },
+        { "PCG ϣ", [](RenderConfig& c) { c.noiseHash = NoiseHash::Pcg; c.backgroundCubemap = 0; } },
+        { "", [](RenderConfig& c) { c.diskNoiseTexture = true; c.backgroundCubemap = 0; } },
+        { "ͼ", [=](RenderConfig& c) { cubemap(c); } },
+        { "͸ұ+ͼ", [=](RenderConfig& c) { c.lensingLut = true; cubemap(c); } },
+    };
+}
+
+double measureFrameTimeMs(const std::function<void(int)>& drawFrame, int frames)
+{
+    drawFrame(0);
+    glFinish();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        drawFrame(frame);
+        glFinish();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+}
+
+int runGpuBenchmark(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return -1;
+
+    RenderTarget target;
+    if (!createRenderTarget(target, config.width, config.height, GL_RGBA8))
+    {
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+
+    std::cout << "GL_RENDERER" << glGetString(GL_RENDERER) << "\n"
+        << "GPU ʱԱȣ" << config.width << "x" << config.height << "" << config.frames << " ֡" << std::endl;
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    size_t pixelCount = static_cast<size_t>(config.width) * config.height;
+    std::vector<unsigned char> reference(pixelCount * 3), pixels(pixelCount * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    double baselineMs = 0.0;
+    int result = 0;
+
+    std::vector<BenchVariant> variants = benchVariants();
+    for (size_t v = 0; v < variants.size(); v++)
+    {
+        RenderConfig variantConfig = config;
+        variants[v].apply(variantConfig);
+
+        BlackholeRenderer renderer;
+        if (!createBlackholeRenderer(renderer, variantConfig, vertexSource, fragmentSource))
+        {
+            result = -1;
+            continue;
+        }
+
+        bindRenderTarget(target);
+        double ms = measureFrameTimeMs([&](int frame)
+        {
+            float time = config.startTime + frame * config.timeStep;
+            drawBlackhole(renderer, time, w, h, config.mouseX * w, config.mouseY * h);
+        }, config.frames);
+
+        // ͬһ֡ʼ iTimeĻԭʼѭԱ
+        drawBlackhole(renderer, config.startTime, w, h, config.mouseX * w, config.mouseY * h);
+        glReadPixels(0, 0, config.width, config.height, GL_RGB, GL_UNSIGNED_BYTE, v == 0 ? reference.data() : pixels.data());
+        std::string traced;
+        if (renderer.adaptive)
+            pollAdaptiveRefine(renderer.refine);
+        if (renderer.adaptive && renderer.refine.measuredFrames > 0)
+        {
+            traced = "׷ " + std::to_string(100.0 * renderer.refine.tracedSum / renderer.refine.measuredFrames) + "% ";
+        }
+        // --count-stepsÿ֡زбĺʱζ
+        if (renderer.countSteps && renderer.steps.countedFrames > 0)
+            traced += "ƽ " + std::to_string(renderer.steps.stepsSum / renderer.steps.countedFrames) + " /";
+        deleteBlackholeRenderer(renderer);
+
+        if (v == 0)
+        {
+            baselineMs = ms;
+            std::cout << variants[v].name << "" << ms << " ms/֡" << traced << std::endl;
+            continue;
+        }
+
+        double sum = 0.0;
+        size_t outliers = 0;
+        for (size_t i = 0; i < pixelCount; i++)
+        {
+            int pixelMax = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                int d = std::abs(static_cast<int>(reference[i * 3 + k]) - static_cast<int>(pixels[i * 3 + k]));
+                sum += d;
+                pixelMax = std::max(pixelMax, d);
+            }
+            if (pixelMax > 8)
+                outliers++;
+        }
+        std::cout << variants[v].name << "" << ms << " ms/֡ٱ " << baselineMs / ms
+            << "xÿ֡ʡ " << baselineMs - ms << " msԭʼѭƽ " << sum / (pixelCount * 3) << " / 255 > 8  "
+            << 100.0 * outliers / pixelCount << "%" << traced << std::endl;
+    }
+
+    deleteRenderTarget(target);
+    destroyOffscreenContext(ctx);
+    return result;
+}
+
+// صõ֡ժҪFNV-1aͬʱģ consumer ÿֽ
+static unsigned long long frameChecksum(const unsigned char* rgb, size_t size)
+{
+    unsigned long long hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= rgb[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+int runCaptureBenchmark(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return -1;
+
+    BlackholeRenderer renderer;
+    RenderTarget target;
+    if (!createBlackholeRenderer(renderer, config, vertexSource, fragmentSource))
+    {
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    if (!createRenderTarget(target, config.width, config.height, GL_RGBA8))
+    {
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+
+    int ringSize = config.captureRing > 0 ? config.captureRing : 3;
+    std::cout << "GL_RENDERER" << glGetString(GL_RENDERER) << "\n"
+        << "֡ؿԱȣ" << config.width << "x" << config.height << "" << config.frames << " ֡PBO  "
+        << ringSize << " " << std::endl;
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    size_t frameSize = static_cast<size_t>(config.width) * config.height * 3;
+    std::vector<unsigned char> pixels(frameSize);
+    std::vector<unsigned long long> syncChecksums(config.frames), asyncChecksums(config.frames);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    // ύ config.frames ֡֡ glFinish CPU  GPU صʱȴȫ
+    auto runFrames = [&](const std::function<void(int)>& afterDraw, const std::function<void()>& finish)
+    {
+        bindRenderTarget(target);
+        drawBlackhole(renderer, config.startTime, w, h, config.mouseX * w, config.mouseY * h);
+        glFinish();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < config.frames; frame++)
+        {
+            float time = config.startTime + frame * config.timeStep;
+            bindRenderTarget(target);
+            drawBlackhole(renderer, time, w, h, config.mouseX * w, config.mouseY * h);
+            afterDraw(frame);
+            // ൱ڽ壺ÿ֡ύһΡ llvmpipe Ѻһ֡ȫǵĻƶصĻ׼ֻȾһ֡
+            glFlush();
+        }
+        finish();
+        glFinish();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / config.frames;
+    };
+
+    double noneMs = runFrames([](int) {}, []() {});
+    double syncMs = runFrames([&](int frame)
+    {
+        glReadPixels(0, 0, config.width, config.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        syncChecksums[frame] = frameChecksum(pixels.data(), frameSize);
+    }, []() {});
+
+    FrameCapture capture;
+    int result = 0;
+    if (createFrameCapture(capture, config.width, config.height, ringSize,
+        [&](long long frame, const unsigned char* rgb, int width, int height)
+        {
+            asyncChecksums[static_cast<size_t>(frame)] = frameChecksum(rgb, static_cast<size_t>(width) * height * 3);
+        }))
+    {
+        double asyncMs = runFrames([&](int frame) { captureFrame(capture, frame); }, [&]() { flushFrameCapture(capture); });
+
+        int mismatched = 0;
+        for (int frame = 0; frame < config.frames; frame++)
+        {
+            if (syncChecksums[frame] != asyncChecksums[frame])
+                mismatched++;
+        }
+        std::cout << "أ" << noneMs << " ms/֡\n"
+            << "ͬ glReadPixels" << syncMs << " ms/֡ " << syncMs - noneMs << " ms"
+            << 100.0 * (syncMs - noneMs) / noneMs << "%\n"
+            << "PBO " << asyncMs << " ms/֡ " << asyncMs - noneMs << " ms"
+            << 100.0 * (asyncMs - noneMs) / noneMs << "%ȴ GPU " << capture.stalls << " Σ"
+            << capture.waitMs / config.frames << " ms/֡ " << capture.issueMs / config.frames
+            << " ms/֡ӳص " << capture.mapMs / config.frames << " ms/֡\n"
+            << "ͬݲͬ֡" << mismatched << " / " << config.frames << std::endl;
+        if (mismatched > 0)
+            result = -1;
+        deleteFrameCapture(capture);
+    }
+    else
+        result = -1;
+
+    deleteRenderTarget(target);
+    deleteBlackholeRenderer(renderer);
+    destroyOffscreenContext(ctx);
+    return result;
+}
+
+int runContextBenchmark(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    int maxContexts = config.contexts > 1 ? config.contexts : hardwareThreadCount();
+    std::vector<int> counts;
+    for (int k = 1; k < maxContexts; k *= 2)
+        counts.push_back(k);
+    counts.push_back(maxContexts);
+
+    std::cout << "£" << config.width << "x" << config.height << "" << config.frames << " ֡ 1 ~ "
+        << maxContexts << "Ӳ߳ " << hardwareThreadCount() << " " << std::endl;
+
+    size_t frameSize = static_cast<size_t>(config.width) * config.height * 3;
+    std::vector<unsigned long long> reference(config.frames), checksums(config.frames);
+    double baseFps = 0.0;
+    int result = 0;
+    for (int k : counts)
+    {
+        ParallelRenderStats stats;
+        bool ok = renderFramesParallel(config, vertexSource, fragmentSource, k, 0, config.frames,
+            [&](int index) { return config.startTime + index * config.timeStep; },
+            [&](int index, const unsigned char* rgb)
+            {
+                checksums[index] = frameChecksum(rgb, frameSize);
+                return true;
+            }, stats);
+        if (!ok)
+            return -1;
+
+        // ²еĳʼ
+        double fps = config.frames / (stats.renderMs / 1000.0);
+        if (k == 1)
+        {
+            baseFps = fps;
+            reference = checksums;
+        }
+        int mismatched = 0;
+        for (int frame = 0; frame < config.frames; frame++)
+            mismatched += checksums[frame] != reference[frame] ? 1 : 0;
+        std::cout << k << " ģ" << fps << " ֡/s " << fps / baseFps << " ʼ " << stats.setupMs
+            << " ms뵥Ĳͬ֡ " << mismatched << " / " << config.frames << std::endl;
+        if (mismatched > 0)
+            result = -1;
+    }
+    return result;
+}
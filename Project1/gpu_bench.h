@@ -0,0 +1,18 @@
+#pragma once
+#include <functional>
+#include "render_config.h"
+
+// --bench EGL Ⱦɫ壨ԭʼѭ͸ұ
+// ƽ֡ʱԭʼɫĻԱ
+int runGpuBenchmark(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
+
+// --capture-benchͬһֱ֡𲻶ءÿ֡ͬ glReadPixels PBO 첽أconfig.captureRing 
+// Ĭ 3ύǽʱȽÿ֡˶ֶصõ֡ͬ
+int runCaptureBenchmark(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
+
+// --contexts-bench k ȡ 124ֱ config.contextsΪ 1 ʱȡӲ߳
+// ÿ renderFramesParallel Ⱦͬһ֡¡Եĵļٱȣ˶Ը k ֡ͬ
+int runContextBenchmark(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
+
+// ƽ֡ʱmsԤһ֮֡ÿ֡ glFinish ʱ
+double measureFrameTimeMs(const std::function<void(int)>& drawFrame, int frames);
@@ -0,0 +1,179 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <iostream>
+#include "gpu_profiler.h"
+
+// ڵķλȣ
+static double percentile(const std::vector<double>& history, double p)
+{
+    if (history.empty())
+        return 0.0;
+    std::vector<double> sorted = history;
+    size_t rank = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+static void pushHistory(GpuProfiler& profiler, std::vector<double>& history, double value)
+{
+    if (static_cast<int>(history.size()) < profiler.window)
+        history.push_back(value);
+    else
+        history[profiler.historyPos] = value;
+}
+
+static void recordTiming(GpuProfiler& profiler, const GpuFrameTiming& timing)
+{
+    profiler.latest = timing;
+    pushHistory(profiler, profiler.cpuHistory, timing.cpuMs);
+    pushHistory(profiler, profiler.gpuHistory, timing.gpuMs);
+    profiler.historyPos = (profiler.historyPos + 1) % profiler.window;
+
+    double p50 = percentile(profiler.gpuHistory, 0.50);
+    double p95 = percentile(profiler.gpuHistory, 0.95);
+    double p99 = percentile(profiler.gpuHistory, 0.99);
+
+    if (profiler.csv.is_open())
+    {
+        // һ֡ʱ֪ pass 
+        if (profiler.resolved == 0)
+        {
+            profiler.csv << "frame,cpu_ms,gpu_ms";
+            for (int i = 0; i < timing.passCount; i++)
+                profiler.csv << "," << profiler.passNames[i] << "_ms";
+            profiler.csv << ",gpu_p50_ms,gpu_p95_ms,gpu_p99_ms\n";
+        }
+        profiler.csv << timing.frame << "," << timing.cpuMs << "," << timing.gpuMs;
+        for (int i = 0; i < timing.passCount; i++)
+            profiler.csv << "," << timing.passMs[i];
+        profiler.csv << "," << p50 << "," << p95 << "," << p99 << "\n";
+    }
+
+    if (profiler.reportInterval > 0 && (profiler.resolved + 1) % profiler.reportInterval == 0)
+    {
+        std::cout << "֡ " << timing.frame << "CPU " << timing.cpuMs << " msGPU " << timing.gpuMs
+            << " msp50 " << p50 << " / p95 " << p95 << " / p99 " << p99 << " ms "
+            << profiler.gpuHistory.size() << " ֡" << std::endl;
+    }
+}
+
+// ύ˳ؽwait Ϊ false ʱδĲѯ
+static void collectTimings(GpuProfiler& profiler, bool wait)
+{
+    while (profiler.resolved < profiler.submitted)
+    {
+        int slot = static_cast<int>(profiler.resolved % GpuProfilerLatency);
+        GpuFrameTiming& timing = profiler.pending[slot];
+
+        if (!wait && timing.passCount > 0)
+        {
+            // ͬһ֡Ĳѯ˳ɣһȫ
+            GLint available = 0;
+            glGetQueryObjectiv(profiler.queries[slot][timing.passCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                return;
+        }
+
+        timing.gpuMs = 0.0;
+        for (int i = 0; i < timing.passCount; i++)
+        {
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(profiler.queries[slot][i], GL_QUERY_RESULT, &ns);
+            timing.passMs[i] = ns * 1e-6;
+            timing.gpuMs += timing.passMs[i];
+        }
+        recordTiming(profiler, timing);
+        profiler.resolved++;
+    }
+}
+
+bool createGpuProfiler(GpuProfiler& profiler, const std::string& csvPath, int reportInterval)
+{
+    profiler.reportInterval = reportInterval;
+    if (!csvPath.empty())
+    {
+        profiler.csv.open(csvPath);
+        // 
+        if (!profiler.csv)
+        {
+            std::cout << "޷дļ" << csvPath << std::endl;
+            return false;
+        }
+    }
+    glGenQueries(GpuProfilerLatency * GpuProfilerMaxPasses, &profiler.queries[0][0]);
+    return true;
+}
+
+void deleteGpuProfiler(GpuProfiler& profiler)
+{
+    glDeleteQueries(GpuProfilerLatency * GpuProfilerMaxPasses, &profiler.queries[0][0]);
+    profiler.csv.close();
+}
+
+void beginProfilerFrame(GpuProfiler& profiler)
+{
+    profiler.frameStart = std::chrono::steady_clock::now();
+
+    // ѯGPU 󳬹 GpuProfilerLatency ֡ʱһ֡ǵȴ
+    if (profiler.submitted - profiler.resolved >= GpuProfilerLatency)
+        collectTimings(profiler, false);
+    profiler.recording = profiler.submitted - profiler.resolved < GpuProfilerLatency;
+    if (!profiler.recording)
+    {
+        profiler.dropped++;
+        return;
+    }
+
+    GpuFrameTiming& timing = profiler.pending[profiler.submitted % GpuProfilerLatency];
+    timing = GpuFrameTiming();
+    timing.frame = profiler.frame;
+}
+
+void beginProfilerPass(GpuProfiler& profiler, const char* name)
+{
+    if (!profiler.recording)
+        return;
+    int slot = static_cast<int>(profiler.submitted % GpuProfilerLatency);
+    GpuFrameTiming& timing = profiler.pending[slot];
+    if (timing.passCount >= GpuProfilerMaxPasses)
+        return;
+
+    profiler.passNames[timing.passCount] = name;
+    glBeginQuery(GL_TIME_ELAPSED, profiler.queries[slot][timing.passCount]);
+    profiler.passOpen = true;
+}
+
+void endProfilerPass(GpuProfiler& profiler)
+{
+    if (!profiler.passOpen)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    profiler.pending[profiler.submitted % GpuProfilerLatency].passCount++;
+    profiler.passOpen = false;
+}
+
+void endProfilerFrame(GpuProfiler& profiler)
+{
+    if (profiler.recording)
+    {
+        GpuFrameTiming& timing = profiler.pending[profiler.submitted % GpuProfilerLatency];
+        timing.cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - profiler.frameStart).count();
+        profiler.submitted++;
+        profiler.recording = false;
+    }
+    profiler.frame++;
+    collectTimings(profiler, false);
+}
+
+void finishGpuProfiler(GpuProfiler& profiler)
+{
+    collectTimings(profiler, true);
+    if (profiler.gpuHistory.empty())
+        return;
+
+    std::cout << "GPU " << profiler.resolved << " ֡Ѽʱ" << profiler.dropped << " ֡ѯδ\n"
+        << "  CPU ֡ʱ p50 " << percentile(profiler.cpuHistory, 0.50) << " / p95 " << percentile(profiler.cpuHistory, 0.95)
+        << " / p99 " << percentile(profiler.cpuHistory, 0.99) << " ms\n"
+        << "  GPU ֡ʱ p50 " << percentile(profiler.gpuHistory, 0.50) << " / p95 " << percentile(profiler.gpuHistory, 0.95)
+        << " / p99 " << percentile(profiler.gpuHistory, 0.99) << " ms " << profiler.gpuHistory.size() << " ֡" << std::endl;
+}
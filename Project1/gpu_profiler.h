@@ -0,0 +1,58 @@
+#pragma once
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ÿ֡ʱ pass 
+const int GpuProfilerMaxPasses = 4;
+// ѯ󻷵֡ N ֡Ľڵ N + GpuProfilerLatency - 1 ֮֡ǰأ
+// ǰȲѯ GL_QUERY_RESULT_AVAILABLEȴ GPU
+const int GpuProfilerLatency = 4;
+
+// һ֡ļʱ
+struct GpuFrameTiming
+{
+    long long frame = 0;
+    double cpuMs = 0.0;                         // beginProfilerFrame  endProfilerFrame  CPU ǽʱ
+    double gpuMs = 0.0;                         //  pass  GPU ʱ֮
+    double passMs[GpuProfilerMaxPasses] = {};
+    int passCount = 0;
+};
+
+// GPU ֡ÿ pass һ GL_TIME_ELAPSED ѯѯֻ֡ʹã
+// ӳټ֡أ CPU/GPU ֡ʱ估ڵ p50/p95/p99
+struct GpuProfiler
+{
+    unsigned int queries[GpuProfilerLatency][GpuProfilerMaxPasses] = {};
+    GpuFrameTiming pending[GpuProfilerLatency];
+    const char* passNames[GpuProfilerMaxPasses] = {};
+    long long submitted = 0;    // ύ֡
+    long long resolved = 0;     // Ѷص֡
+    long long dropped = 0;      // ѯδʱ֡
+    bool recording = false;     // ǰ֡Ƿڼʱ
+    bool passOpen = false;
+    long long frame = 0;        // ǰ֡ţδʱ֡
+    std::chrono::steady_clock::time_point frameStart;
+
+    int window = 240;           // λͳƵĻڣ֡
+    int reportInterval = 60;    // ÿ֡ stdout һΣ0 ʾ
+    GpuFrameTiming latest;      // صһ֡resolved > 0 ʱЧ
+    std::vector<double> cpuHistory, gpuHistory;
+    int historyPos = 0;
+    std::ofstream csv;
+};
+
+// Ҫǰ GL ģcsvPath ǿʱÿ֡дһ CSVʧʱ false
+bool createGpuProfiler(GpuProfiler& profiler, const std::string& csvPath, int reportInterval);
+void deleteGpuProfiler(GpuProfiler& profiler);
+
+void beginProfilerFrame(GpuProfiler& profiler);
+// name ỰЧһΪַͬһ֡ڰ̶˳
+void beginProfilerPass(GpuProfiler& profiler, const char* name);
+void endProfilerPass(GpuProfiler& profiler);
+// ύǰ֡Ѿľ֡
+void endProfilerFrame(GpuProfiler& profiler);
+
+// ȴδصĲѯܣֻڽʱã
+void finishGpuProfiler(GpuProfiler& profiler);
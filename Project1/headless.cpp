@@ -0,0 +1,259 @@
+#include <glad/glad.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "headless.h"
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+#include "image_write.h"
+#include "gpu_profiler.h"
+#include "dynamic_resolution.h"
+#include "frame_capture.h"
+#include "parallel_render.h"
+
+// ģ--contexts߳Ⱦ֡ڱ̰߳֡˳дļ
+static int runHeadlessParallel(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    if (config.profile || config.dynamicResolution > 0.0f || config.captureRing > 0)
+        std::cout << "Ⱦ֧ --profile--dynamic-resolution--capture-ring" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    ParallelRenderStats stats;
+    bool ok = renderFramesParallel(config, vertexSource, fragmentSource, config.contexts, config.startFrame, config.frames,
+        [&](int index) { return config.startTime + index * config.timeStep; },
+        [&](int index, const unsigned char* rgb)
+        {
+            std::string path = formatFramePath(config.output, index);
+            if (!writeImagePPM(path, config.width, config.height, rgb, true))
+                return false;
+            std::cout << "д룺" << path << std::endl;
+            return true;
+        }, stats);
+    if (!ok)
+        return -1;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << config.frames << " ֡ʱ " << seconds << " s" << config.frames / seconds << " ֡/s"
+        << config.contexts << " ģʼ " << stats.setupMs << " ms " << config.frames / (stats.renderMs / 1000.0)
+        << " ֡/s" << std::endl;
+    return 0;
+}
+
+int runHeadless(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    if (config.contexts > 1)
+        return runHeadlessParallel(config, vertexSource, fragmentSource);
+
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return -1;
+
+    std::cout << "GL_RENDERER" << glGetString(GL_RENDERER) << std::endl;
+
+    BlackholeRenderer renderer;
+    if (!createBlackholeRenderer(renderer, config, vertexSource, fragmentSource))
+    {
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    RenderTarget target;
+    if (!createRenderTarget(target, config.width, config.height, GL_RGBA8))
+    {
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+
+    GpuProfiler profiler;
+    if (config.profile && !createGpuProfiler(profiler, config.profileCsv, 60))
+    {
+        deleteRenderTarget(target);
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+
+    // ֱ̬ʣÿ֡ҪأglReadPixels ͻȴ GPU ɣ
+    // ֱûƵؽǽʱllvmpipe ļʱѯ
+    bool dynamicResolution = config.dynamicResolution > 0.0f;
+    DynamicResolution dr;
+    if (dynamicResolution && !createDynamicResolution(dr, config, config.width, config.height, vertexSource))
+    {
+        if (config.profile)
+            deleteGpuProfiler(profiler);
+        deleteRenderTarget(target);
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+
+    // 첽أ--capture-ring֡ ring ֮֡ɻصдļֱ̬ʰÿ֡ͬؼʱ
+    bool asyncCapture = config.captureRing > 0 && !dynamicResolution;
+    if (config.captureRing > 0 && dynamicResolution)
+        std::cout << "ֱ̬ʰÿ֡ͬؼʱ --capture-ring" << std::endl;
+    FrameCapture capture;
+    bool writeFailed = false;
+    if (asyncCapture && !createFrameCapture(capture, config.width, config.height, config.captureRing,
+        [&](long long frame, const unsigned char* rgb, int width, int height)
+        {
+            std::string path = formatFramePath(config.output, static_cast<int>(frame));
+            if (writeImagePPM(path, width, height, rgb, true))
+                std::cout << "д룺" << path << std::endl;
+            else
+                writeFailed = true;
+        }))
+    {
+        if (dynamicResolution)
+            deleteDynamicResolution(dr);
+        if (config.profile)
+            deleteGpuProfiler(profiler);
+        deleteRenderTarget(target);
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(config.width) * config.height * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    int result = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < config.frames; frame++)
+    {
+        // ̶ƽ iTimeٶ޹أȫ֡ż㣬ֶȾĽֱƴ
+        int index = config.startFrame + frame;
+        float time = config.startTime + index * config.timeStep;
+        if (config.profile)
+            beginProfilerFrame(profiler);
+
+        auto frameStart = std::chrono::steady_clock::now();
+
+        if (dynamicResolution)
+        {
+            float rw = static_cast<float>(dynamicRenderWidth(dr));
+            float rh = static_cast<float>(dynamicRenderHeight(dr));
+            bindDynamicResolution(dr);
+            if (config.profile)
+                beginProfilerPass(profiler, "blackhole");
+            drawBlackhole(renderer, time, rw, rh, config.mouseX * rw, config.mouseY * rh);
+            if (config.profile)
+            {
+                endProfilerPass(profiler);
+                beginProfilerPass(profiler, "upscale");
+            }
+            bindRenderTarget(target);
+            drawDynamicUpscale(dr, renderer.quad);
+        }
+        else
+        {
+            bindRenderTarget(target);
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            if (config.profile)
+                beginProfilerPass(profiler, "blackhole");
+            drawBlackhole(renderer, time, w, h, config.mouseX * w, config.mouseY * h);
+        }
+        if (config.profile)
+        {
+            endProfilerPass(profiler);
+            beginProfilerPass(profiler, "readback");
+        }
+
+        if (asyncCapture)
+        {
+            captureFrame(capture, index);
+            if (renderer.tileClassify)
+                countTileClasses(renderer.tiles);
+            if (config.profile)
+            {
+                endProfilerPass(profiler);
+                endProfilerFrame(profiler);
+            }
+            if (writeFailed)
+            {
+                result = -1;
+                break;
+            }
+            continue;
+        }
+        glReadPixels(0, 0, config.width, config.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        if (config.profile)
+            endProfilerPass(profiler);
+
+        double frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+        int renderWidth = dynamicResolution ? dynamicRenderWidth(dr) : config.width;
+        int renderHeight = dynamicResolution ? dynamicRenderHeight(dr) : config.height;
+        if (dynamicResolution)
+            updateDynamicResolution(dr, frameMs);
+        std::string path = formatFramePath(config.output, index);
+        if (!writeImagePPM(path, config.width, config.height, pixels.data(), true))
+        {
+            result = -1;
+            break;
+        }
+        std::cout << "д룺" << path;
+        if (dynamicResolution)
+            std::cout << "Ⱦ " << renderWidth << "x" << renderHeight << "" << frameMs << " ms";
+        if (renderer.tileClassify)
+            countTileClasses(renderer.tiles);
+        if (renderer.adaptive)
+        {
+            // glReadPixels ֮֡ڵѯѾ
+            pollAdaptiveRefine(renderer.refine);
+            std::cout << "׷ " << 100.0 * renderer.refine.tracedFraction << "% أ";
+        }
+        if (renderer.countSteps)
+            std::cout << "ƽ " << renderer.steps.averageSteps << " /ߣ";
+        std::cout << std::endl;
+        if (config.profile)
+            endProfilerFrame(profiler);
+    }
+
+    if (asyncCapture)
+    {
+        flushFrameCapture(capture);
+        if (writeFailed)
+            result = -1;
+        std::cout << "첽أ" << capture.ringSize << "  PBOȴ GPU " << capture.stalls << " Σ"
+            << capture.waitMs << " ms " << capture.issueMs / config.frames << " ms/֡ӳдļ "
+            << capture.mapMs / config.frames << " ms/֡" << std::endl;
+        deleteFrameCapture(capture);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << config.frames << " ֡ʱ " << seconds << " s"
+        << config.frames / seconds << " ֡/s" << std::endl;
+    if (renderer.geodesicCache)
+        std::cout << "߻棺ؽ " << renderer.geodesic.rebuilds << " Σ " << renderer.geodesic.reuses << " ֡" << std::endl;
+    if (renderer.tileClassify && renderer.tiles.countedFrames > 0)
+    {
+        const long long* counts = renderer.tiles.tileCounts;
+        double total = static_cast<double>(counts[0] + counts[1] + counts[2]);
+        std::cout << "Ƭࣺ " << 100.0 * counts[0] / total << "% " << 100.0 * counts[1] / total
+            << "%ӽ " << 100.0 * counts[2] / total << "%" << std::endl;
+    }
+    if (renderer.adaptive && renderer.refine.measuredFrames > 0)
+        std::cout << "Ӧϸƽ׷ " << 100.0 * renderer.refine.tracedSum / renderer.refine.measuredFrames
+            << "% أ" << renderer.refine.measuredFrames << " ֡" << std::endl;
+    if (renderer.countSteps && renderer.steps.countedFrames > 0)
+        std::cout << "ֲƽ " << renderer.steps.stepsSum / renderer.steps.countedFrames
+            << " /ߣ" << renderer.steps.countedFrames << " ֡" << std::endl;
+
+    if (dynamicResolution)
+        deleteDynamicResolution(dr);
+    if (config.profile)
+    {
+        finishGpuProfiler(profiler);
+        deleteGpuProfiler(profiler);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    deleteRenderTarget(target);
+    deleteBlackholeRenderer(renderer);
+    destroyOffscreenContext(ctx);
+    return result;
+}
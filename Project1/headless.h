@@ -0,0 +1,5 @@
+#pragma once
+#include "render_config.h"
+
+// ޴ģʽ EGL аѺڶȾ FBO֡д
+int runHeadless(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
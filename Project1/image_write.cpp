@@ -0,0 +1,157 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "image_write.h"
+
+bool writeImagePPM(const std::string& path, int width, int height, const unsigned char* rgb, bool flipY)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cout << "޷дͼļ" << path << std::endl;
+        return false;
+    }
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+    size_t rowSize = static_cast<size_t>(width) * 3;
+    for (int y = 0; y < height; y++)
+    {
+        int srcRow = flipY ? (height - 1 - y) : y;
+        file.write(reinterpret_cast<const char*>(rgb + srcRow * rowSize), rowSize);
+    }
+    return static_cast<bool>(file);
+}
+
+std::string encodeImagePPM(int width, int height, const unsigned char* rgb, bool flipY)
+{
+    std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+    size_t rowSize = static_cast<size_t>(width) * 3;
+    std::string image;
+    image.reserve(header.size() + rowSize * height);
+    image += header;
+    for (int y = 0; y < height; y++)
+    {
+        int srcRow = flipY ? (height - 1 - y) : y;
+        image.append(reinterpret_cast<const char*>(rgb + srcRow * rowSize), rowSize);
+    }
+    return image;
+}
+
+bool beginImagePPM(ImageStreamPPM& stream, const std::string& path, int width, int height)
+{
+    stream.file.open(path, std::ios::binary);
+    if (!stream.file)
+    {
+        std::cout << "޷дͼļ" << path << std::endl;
+        return false;
+    }
+    stream.path = path;
+    stream.width = width;
+    stream.height = height;
+    stream.rowsWritten = 0;
+    stream.file << "P6\n" << width << " " << height << "\n255\n";
+    return static_cast<bool>(stream.file);
+}
+
+bool writeImageRowsPPM(ImageStreamPPM& stream, const unsigned char* rgb, int rows, bool flipY)
+{
+    size_t rowSize = static_cast<size_t>(stream.width) * 3;
+    for (int y = 0; y < rows; y++)
+    {
+        int srcRow = flipY ? (rows - 1 - y) : y;
+        stream.file.write(reinterpret_cast<const char*>(rgb + srcRow * rowSize), rowSize);
+    }
+    stream.rowsWritten += rows;
+    if (!stream.file)
+    {
+        std::cout << "дͼļʧܣ" << stream.path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool endImagePPM(ImageStreamPPM& stream)
+{
+    stream.file.close();
+    // 
+    if (stream.rowsWritten != stream.height || !stream.file)
+    {
+        std::cout << "ͼļ" << stream.path << "" << stream.rowsWritten << " / " << stream.height << " У" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//  pattern[pos]  % ͷռλ%%  0%d / %Nd / %0Nd  1 ȺͲ㣬 -1
+static int parseFrameConversion(const std::string& pattern, size_t& pos, int& width, bool& zeroPad)
+{
+    pos++;
+    if (pos < pattern.size() && pattern[pos] == '%')
+    {
+        pos++;
+        return 0;
+    }
+    zeroPad = pos < pattern.size() && pattern[pos] == '0';
+    if (zeroPad)
+        pos++;
+    width = 0;
+    for (int digits = 0; pos < pattern.size() && pattern[pos] >= '0' && pattern[pos] <= '9'; digits++, pos++)
+    {
+        if (digits == 2)
+            return -1;  // λ
+        width = width * 10 + (pattern[pos] - '0');
+    }
+    if (pos >= pattern.size() || pattern[pos] != 'd')
+        return -1;
+    pos++;
+    return 1;
+}
+
+bool validFramePattern(const std::string& pattern)
+{
+    int conversions = 0;
+    for (size_t pos = 0; pos < pattern.size();)
+    {
+        if (pattern[pos] != '%')
+        {
+            pos++;
+            continue;
+        }
+        int width;
+        bool zeroPad;
+        int result = parseFrameConversion(pattern, pos, width, zeroPad);
+        if (result < 0)
+            return false;
+        conversions += result;
+    }
+    return conversions == 1;
+}
+
+std::string formatFramePath(const std::string& pattern, int frameIndex)
+{
+    // Լ滻ռλûģ嵱 printf ʽ
+    std::string path;
+    for (size_t pos = 0; pos < pattern.size();)
+    {
+        if (pattern[pos] != '%')
+        {
+            path += pattern[pos++];
+            continue;
+        }
+        int width = 0;
+        bool zeroPad = false;
+        if (parseFrameConversion(pattern, pos, width, zeroPad) == 0)
+        {
+            path += '%';
+            continue;
+        }
+        std::string digits = std::to_string(frameIndex < 0 ? -static_cast<long long>(frameIndex) : frameIndex);
+        std::string sign = frameIndex < 0 ? "-" : "";
+        int padding = width - static_cast<int>(sign.size() + digits.size());
+        if (padding > 0)
+            path += zeroPad ? sign + std::string(padding, '0') + digits : std::string(padding, ' ') + sign + digits;
+        else
+            path += sign + digits;
+    }
+    return path;
+}
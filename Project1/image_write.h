@@ -0,0 +1,30 @@
+#pragma once
+#include <fstream>
+#include <string>
+
+// д PPMP6RGB 8 λflipY Ϊ true ʱ glReadPixels ¶ת
+bool writeImagePPM(const std::string& path, int width, int height, const unsigned char* rgb, bool flipY);
+
+// Ϊڴе PPMP6ͨ׽ֱֵӷͣflipY ͬ writeImagePPM
+std::string encodeImagePPM(int width, int height, const unsigned char* rgb, bool flipY);
+
+// ʽд PPMдļͷ֮϶µ˳׷УͼҪͬʱڴ
+struct ImageStreamPPM
+{
+    std::ofstream file;
+    std::string path;
+    int width = 0;
+    int height = 0;
+    int rowsWritten = 0;
+};
+
+bool beginImagePPM(ImageStreamPPM& stream, const std::string& path, int width, int height);
+// ׷ rows Уÿ width  RGB أflipY ͬ writeImagePPMֻһڷת
+bool writeImageRowsPPM(ImageStreamPPM& stream, const unsigned char* rgb, int rows, bool flipY);
+// رļд height ʱ false
+bool endImagePPM(ImageStreamPPM& stream);
+
+// ֡ļģǡúһ %d / %Nd / %0Ndλ % д %%
+bool validFramePattern(const std::string& pattern);
+// ģ֡ļ "frame_%04d.ppm"ģӦȾ validFramePattern 
+std::string formatFramePath(const std::string& pattern, int frameIndex);
@@ -0,0 +1,197 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "lensing_lut.h"
+#include "task_scheduler.h"
+
+// ұֱ
+static const int AlphaSamples = 512;
+static const int R0Samples = 128;
+static const int PhiSamples = 64;
+// 뷶Χpos = (0, 0.05, -m*m*0.05)m  iMouse.x ԶԼ 14
+// ͸ЧӦͻԹ仯ңr0  u = log(r0 / min) / log(max / min) Լദͬ
+static const float R0Min = 0.05f;
+static const float R0Max = 14.5f;
+
+static const double Pi = 3.14159265358979;
+
+// ƽڵһ߹켣ɫѭһ£ֻȥ pos.y ƣ
+struct PlanarPath
+{
+    std::vector<double> phi;    // ÿļǣչ
+    std::vector<double> x, y;   // 
+    std::vector<double> theta;  // Ӷ i-1  i һεĹ߷
+    double glow = 0.0;
+    float termination = 0.5f;   // 0 = ݣ1 = ڶգ0.5 = þ
+};
+
+// ѽǶȲһ (-pi, pi]
+static double wrapAngle(double a)
+{
+    while (a > Pi) a -= 2.0 * Pi;
+    while (a <= -Pi) a += 2.0 * Pi;
+    return a;
+}
+
+// diskIterations x bendSteps ɫ DISK_ITERATIONS x BEND_STEPS һ£þĹͬ 0.5 ֹ
+static void tracePlanar(double alpha, double r0, double size, int diskIterations, int bendSteps, PlanarPath& path)
+{
+    double px = r0, py = 0.0;
+    double rx = std::cos(alpha), ry = std::sin(alpha);
+    path.phi.assign(1, 0.0);
+    path.x.assign(1, px);
+    path.y.assign(1, py);
+    path.theta.assign(1, alpha);
+    path.glow = 0.0;
+    path.termination = 0.5f;
+
+    for (int disks = 0; disks < diskIterations; disks++)
+    {
+        for (int h = 0; h < bendSteps; h++)
+        {
+            double dotpos = px * px + py * py;
+            double invDist = 1.0 / std::sqrt(dotpos);
+            double centDist = dotpos * invDist;
+            double farLimit = centDist * 0.5;
+            double closeLimit = centDist * 0.1 + 0.05 * centDist * centDist * (1.0 / size);
+            double stepDist = std::min(farLimit, closeLimit);
+
+            double invDistSqr = invDist * invDist;
+            double bendForce = stepDist * invDistSqr * size * 0.625;
+            rx -= bendForce * invDist * px;
+            ry -= bendForce * invDist * py;
+            double len = std::sqrt(rx * rx + ry * ry);
+            rx /= len;
+            ry /= len;
+            px += stepDist * rx;
+            py += stepDist * ry;
+
+            path.glow += 0.01 * stepDist * invDistSqr * invDistSqr * std::min(std::max(centDist * 2.0 - 1.2, 0.0), 1.0);
+
+            double prevPhi = path.phi.back();
+            double prevTheta = path.theta.back();
+            path.phi.push_back(prevPhi + wrapAngle(std::atan2(py, px) - std::atan2(path.y.back(), path.x.back())));
+            path.theta.push_back(prevTheta + wrapAngle(std::atan2(ry, rx) - prevTheta));
+            path.x.push_back(px);
+            path.y.push_back(py);
+        }
+
+        double dist2 = std::sqrt(px * px + py * py);
+        if (dist2 < size * 0.1)
+        {
+            path.termination = 1.0f;
+            break;
+        }
+        else if (dist2 > size * 1000.0)
+        {
+            path.termination = 0.0f;
+            break;
+        }
+    }
+}
+
+// 켣ڼ phi İ뾶߷ǣֱ߶ԭ󽻡
+// Ƕغʹ phi i Ϊһβҵ߶Σ˳ѯʱ
+static void samplePath(const PlanarPath& path, double phi, size_t& i, float& r, float& theta)
+{
+    while (i + 1 < path.phi.size() && path.phi[i] < phi)
+        i++;
+    double ux = std::cos(phi), uy = std::sin(phi);
+    double ax = path.x[i - 1], ay = path.y[i - 1];
+    double dx = path.x[i] - ax, dy = path.y[i] - ay;
+    double denom = dx * uy - dy * ux;
+    double t = std::fabs(denom) > 1e-12 ? -(ax * uy - ay * ux) / denom : 0.0;
+    t = std::min(std::max(t, 0.0), 1.0);
+    r = static_cast<float>((ax + t * dx) * ux + (ay + t * dy) * uy);
+    theta = static_cast<float>(path.theta[i]);
+}
+
+bool createLensingLut(LensingLut& lut, float size, int diskIterations, int bendSteps)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<float> summary(static_cast<size_t>(AlphaSamples) * R0Samples * 4);
+    std::vector<float> pathData(static_cast<size_t>(PhiSamples) * AlphaSamples * R0Samples * 2);
+    // ÿ r0 Ƭָ߳
+    parallelForWorkStealing(R0Samples, hardwareThreadCount(), [&](int j, int)
+    {
+        PlanarPath path;
+        // λģɫ log(r0 / min) / log(max / min) Ϊ
+        double u = (j + 0.5) / R0Samples;
+        double r0 = R0Min * std::pow(R0Max / R0Min, u);
+        for (int i = 0; i < AlphaSamples; i++)
+        {
+            double alpha = (i + 0.5) / AlphaSamples * Pi;
+            tracePlanar(alpha, r0, size, diskIterations, bendSteps, path);
+
+            double phiEnd = path.phi.back();
+            float* s = &summary[(static_cast<size_t>(j) * AlphaSamples + i) * 4];
+            s[0] = static_cast<float>(phiEnd);
+            s[1] = static_cast<float>(path.theta.back());
+            s[2] = static_cast<float>(path.glow);
+            s[3] = path.termination;
+
+            size_t segment = 1;
+            for (int k = 0; k < PhiSamples; k++)
+            {
+                float* p = &pathData[((static_cast<size_t>(j) * AlphaSamples + i) * PhiSamples + k) * 2];
+                samplePath(path, (k + 0.5) / PhiSamples * phiEnd, segment, p[0], p[1]);
+            }
+        }
+    });
+
+    glGenTextures(1, &lut.summaryTex);
+    glBindTexture(GL_TEXTURE_2D, lut.summaryTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, AlphaSamples, R0Samples, 0, GL_RGBA, GL_FLOAT, summary.data());
+    // ɫ˫㼣ǷԽֹ͵ı߽磬Խʱ texelFetch ֻȡͬ
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenTextures(1, &lut.pathTex);
+    glBindTexture(GL_TEXTURE_3D, lut.pathTex);
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_RG32F, PhiSamples, AlphaSamples, R0Samples, 0, GL_RG, GL_FLOAT, pathData.data());
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    lut.r0Min = R0Min;
+    lut.r0Max = R0Max;
+    lut.bakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (glGetError() != GL_NO_ERROR)
+    {
+        std::cout << "͸ұϴʧܣ" << std::endl;
+        deleteLensingLut(lut);
+        return false;
+    }
+    std::cout << "͸ұ決ɣ" << AlphaSamples << "x" << R0Samples << "· " << PhiSamples
+        << " ǲ" << diskIterations << "x" << bendSteps << " ʱ " << lut.bakeMs << " ms" << std::endl;
+    return true;
+}
+
+void deleteLensingLut(LensingLut& lut)
+{
+    glDeleteTextures(1, &lut.summaryTex);
+    glDeleteTextures(1, &lut.pathTex);
+    lut = LensingLut();
+}
+
+void bindLensingLut(const LensingLut& lut, unsigned int program, int summaryUnit, int pathUnit)
+{
+    glActiveTexture(GL_TEXTURE0 + summaryUnit);
+    glBindTexture(GL_TEXTURE_2D, lut.summaryTex);
+    glActiveTexture(GL_TEXTURE0 + pathUnit);
+    glBindTexture(GL_TEXTURE_3D, lut.pathTex);
+    glActiveTexture(GL_TEXTURE0);
+
+    glUniform1i(glGetUniformLocation(program, "iLensSummary"), summaryUnit);
+    glUniform1i(glGetUniformLocation(program, "iLensPath"), pathUnit);
+    glUniform2f(glGetUniformLocation(program, "iLensRange"), lut.r0Min, lut.r0Max);
+}
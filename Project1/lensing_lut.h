@@ -0,0 +1,23 @@
+#pragma once
+
+// Ԥ͸ұ blackhole.frag ص 20x6 ѭ
+// ǾԳƵģʼλúͳʼųɵƽ˶
+// ֻ谴 ( alpha,  r0) ƽڻһΣ
+//   summaryTex2Dalpha x r0RGBA = ֹʱɨļǡ䷽ǡۻԹ⡢ֹ
+//   pathTex3Dphi x alpha x r0RG =  phi İ뾶 r ߷ǣ̽
+// alpha ǹļнǣ b = r0 * sin(alpha) alpha /Ĺߡ
+struct LensingLut
+{
+    unsigned int summaryTex = 0;
+    unsigned int pathTex = 0;
+    float r0Min = 0.0f;
+    float r0Max = 0.0f;
+    double bakeMs = 0.0;
+};
+
+//  CPU Ϻ決ϴsize ɫе _Size һ£diskIterations/bendSteps ȡʵλѭ
+bool createLensingLut(LensingLut& lut, float size, int diskIterations, int bendSteps);
+void deleteLensingLut(LensingLut& lut);
+
+// 󶨵Ԫ summaryUnit / pathUnit program е iLensSummary / iLensPath / iLensRange
+void bindLensingLut(const LensingLut& lut, unsigned int program, int summaryUnit, int pathUnit);
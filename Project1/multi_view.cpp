@@ -0,0 +1,57 @@
+#include <glad/glad.h>
+#include <cmath>
+#include <vector>
+#include "multi_view.h"
+
+// uniform İ󶨵
+static const int MultiViewBinding = 0;
+
+bool createMultiView(MultiView& mv)
+{
+    glGenBuffers(1, &mv.ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, mv.ubo);
+    glBufferData(GL_UNIFORM_BUFFER, MaxViews * 4 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return mv.ubo != 0;
+}
+
+void deleteMultiView(MultiView& mv)
+{
+    glDeleteBuffers(1, &mv.ubo);
+    mv = MultiView();
+}
+
+void bindMultiView(MultiView& mv, unsigned int program, const BlackholeView* views, int count, int columns, int rows)
+{
+    // std140vec4 ÿԪ 16 ֽ
+    std::vector<float> data(static_cast<size_t>(count) * 4);
+    for (int i = 0; i < count; i++)
+    {
+        data[i * 4 + 0] = views[i].mouseX;
+        data[i * 4 + 1] = views[i].mouseY;
+        data[i * 4 + 2] = views[i].time;
+        data[i * 4 + 3] = 0.0f;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, mv.ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, data.size() * sizeof(float), data.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, MultiViewBinding, mv.ubo);
+
+    glUniformBlockBinding(program, glGetUniformBlockIndex(program, "MultiViews"), MultiViewBinding);
+    glUniform1i(glGetUniformLocation(program, "iViewColumns"), columns);
+    glUniform1i(glGetUniformLocation(program, "iViewRows"), rows);
+}
+
+void drawMultiView(const FullscreenQuad& quad, int count)
+{
+    glBindVertexArray(quad.VAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, count);
+}
+
+void multiViewGrid(int count, int& columns, int& rows)
+{
+    columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    if (columns < 1)
+        columns = 1;
+    rows = (count + columns - 1) / columns;
+}
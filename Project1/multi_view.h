@@ -0,0 +1,33 @@
+#pragma once
+#include "fullscreen_quad.h"
+
+// һζͼͼעɫ MAX_VIEWS һ£std140 ÿͼ 16 ֽڣ
+const int MaxViews = 256;
+
+// ͼһͼmouseX/mouseY Ϊ꣬ drawBlackhole һ£
+struct BlackholeView
+{
+    float time = 0.0f;
+    float mouseX = 0.0f;
+    float mouseY = 0.0f;
+};
+
+// ͼ--viewsͬһĶųͼͼ iTimeiMouse д uniform 壬
+// һʵƣÿʵһȾȫͼuniform ֻһΣ
+// ɫ״̬лĿͼ̯
+struct MultiView
+{
+    unsigned int ubo = 0;
+};
+
+bool createMultiView(MultiView& mv);
+void deleteMultiView(MultiView& mv);
+
+// ϴ count ͼ󶨵 program  MultiViews 飬ͼ
+void bindMultiView(MultiView& mv, unsigned int program, const BlackholeView* views, int count, int columns, int rows);
+
+// ʵȫıΣ i ʵͼ i 
+void drawMultiView(const FullscreenQuad& quad, int count);
+
+// count ͼųɽεͼʱ
+void multiViewGrid(int count, int& columns, int& rows);
@@ -0,0 +1,74 @@
+// ⣺ϣ + ֵ blackhole.frag ͨ #include ã noise_hash.h
+// ϣɺѡ񣬶δʱΪԭ sin Ĺϣ
+//   NOISE_HASH_PCG      PCG ϣJarzynski & Olano 2020ǶΪ pcg(x + pcg(y))
+//   NOISE_HASH_XXHASH   xxHash32 Ķά汾
+//   NOISE_HASH_TEXTURE  Ԥ PCG ϣֵiChannel0ߴѭ
+// ϣֻ 32 λ˷λ򣬽 sin ޹أ GPU λͬ
+
+#if defined(NOISE_HASH_PCG) || defined(NOISE_HASH_XXHASH)
+uint pcgHash(uint v)
+{
+    uint state = v * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+uint xxHash(uvec2 p)
+{
+    const uint PRIME32_2 = 2246822519u;
+    const uint PRIME32_3 = 3266489917u;
+    const uint PRIME32_4 = 668265263u;
+    const uint PRIME32_5 = 374761393u;
+    uint h32 = p.y + PRIME32_5 + p.x * PRIME32_3;
+    h32 = PRIME32_4 * ((h32 << 17) | (h32 >> 15));
+    h32 += p.y * PRIME32_3;
+    h32 = PRIME32_4 * ((h32 << 17) | (h32 >> 15));
+    h32 = PRIME32_2 * (h32 ^ (h32 >> 15));
+    h32 = PRIME32_3 * (h32 ^ (h32 >> 13));
+    return h32 ^ (h32 >> 16);
+}
+
+// ȡ 24 λתΪ [0, 1)float Ծȷʾ
+float hashToFloat(uint h)
+{
+    return float(h >> 8u) * (1.0 / 16777216.0);
+}
+#endif
+
+// ϣx Ϊֵ꣨ float
+#if defined(NOISE_HASH_PCG)
+float hash(vec2 x)
+{
+    uvec2 u = uvec2(ivec2(x));
+    return hashToFloat(pcgHash(u.x + pcgHash(u.y)));
+}
+#elif defined(NOISE_HASH_XXHASH)
+float hash(vec2 x)
+{
+    return hashToFloat(xxHash(uvec2(ivec2(x))));
+}
+#elif defined(NOISE_HASH_TEXTURE)
+//  (i, j) Ϊ PCG ˵ hash(vec2(i, j))궼 [0, NOISE_HASH_TEXTURE_SIZE) ʱֺ˽ͬ
+float hash(vec2 x)
+{
+    return texelFetch(iChannel0, ivec2(x) & (NOISE_HASH_TEXTURE_SIZE - 1), 0).r;
+}
+#else
+float hash(float x){ return fract(sin(x)*152754.742);}
+float hash(vec2 x){	return hash(x.x + hash(x.y));}
+#endif
+
+// ֵ
+float value(vec2 p, float f)
+{
+    float bl = hash(floor(p*f + vec2(0.,0.)));
+    float br = hash(floor(p*f + vec2(1.,0.)));
+    float tl = hash(floor(p*f + vec2(0.,1.)));
+    float tr = hash(floor(p*f + vec2(1.,1.)));
+
+    vec2 fr = fract(p*f);
+    fr = (3.0 - 2.0*fr)*fr*fr;
+    float b = mix(bl, br, fr.x);
+    float t = mix(tl, tr, fr.x);
+    return mix(b, t, fr.y);
+}
@@ -0,0 +1,174 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "noise_bench.h"
+#include "noise_hash.h"
+#include "blackhole_renderer.h"
+#include "gpu_bench.h"
+#include "offscreen_context.h"
+#include "render_target.h"
+#include "shader_read.h"
+
+// value() ϣͳ
+struct NoiseStats
+{
+    double valueMean = 0.0;
+    double valueStd = 0.0;
+    double hashMean = 0.0;
+    double hashCorrelation = 0.0;   // ڸϣϵ
+    double hashMaxError = 0.0;      //  CPU οʵֵ
+    double hashExact = 0.0;         //  CPU οʵλͬĸ
+};
+
+static NoiseStats noiseStats(NoiseHash hash, const std::vector<float>& pixels, int width, int height)
+{
+    NoiseStats stats;
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    double valueSum = 0.0, valueSquares = 0.0, hashSum = 0.0, hashSquares = 0.0, neighbourSum = 0.0;
+    size_t exact = 0;
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            const float* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            valueSum += p[1];
+            valueSquares += static_cast<double>(p[1]) * p[1];
+            hashSum += p[2];
+            hashSquares += static_cast<double>(p[2]) * p[2];
+            if (x + 1 < width)
+                neighbourSum += static_cast<double>(p[2]) * p[6];
+
+            // ɫ floor(iResolution * 0.5) Ϊԭ
+            float reference = noiseHashValue(hash, x - width / 2, y - height / 2);
+            if (reference == p[2])
+                exact++;
+            stats.hashMaxError = std::max(stats.hashMaxError, static_cast<double>(std::fabs(reference - p[2])));
+        }
+    }
+
+    stats.valueMean = valueSum / pixelCount;
+    stats.valueStd = std::sqrt(std::max(0.0, valueSquares / pixelCount - stats.valueMean * stats.valueMean));
+    stats.hashMean = hashSum / pixelCount;
+    double hashVariance = hashSquares / pixelCount - stats.hashMean * stats.hashMean;
+    size_t neighbours = static_cast<size_t>(width - 1) * height;
+    if (hashVariance > 0.0 && neighbours > 0)
+        stats.hashCorrelation = (neighbourSum / neighbours - stats.hashMean * stats.hashMean) / hashVariance;
+    stats.hashExact = static_cast<double>(exact) / pixelCount;
+    return stats;
+}
+
+// ΢׼NOISE_BENCH 廭 RGBA32F Ŀ꣬ʱͳ
+static bool benchNoiseHash(NoiseHash hash, const RenderConfig& config, const char* vertexSource, const char* fragmentSource,
+    const FullscreenQuad& quad, RenderTarget& target, double& ms, NoiseStats& stats)
+{
+    std::string fragment = injectShaderDefines(fragmentSource,
+        noiseHashDefines(hash) + "#define NOISE_BENCH " + std::to_string(NoiseBenchEvaluations) + "\n");
+    BlackholeProgram bh = createBlackholeProgram(vertexSource, fragment.c_str());
+    if (bh.program == 0)
+        return false;
+
+    unsigned int tex = hash == NoiseHash::Texture ? createNoiseHashTexture() : createDummyTexture();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, tex);
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    bindRenderTarget(target);
+    ms = measureFrameTimeMs([&](int frame)
+    {
+        useBlackholeProgram(bh, config.startTime + frame * config.timeStep, w, h, 0.0f, 0.0f);
+        drawFullscreenQuad(quad);
+    }, config.frames);
+
+    std::vector<float> pixels(static_cast<size_t>(config.width) * config.height * 4);
+    glReadPixels(0, 0, config.width, config.height, GL_RGBA, GL_FLOAT, pixels.data());
+    stats = noiseStats(hash, pixels, config.width, config.height);
+
+    glDeleteTextures(1, &tex);
+    deleteBlackholeProgram(bh);
+    return glGetError() == GL_NO_ERROR;
+}
+
+int runNoiseBenchmark(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return -1;
+
+    RenderTarget noiseTarget, sceneTarget;
+    if (!createRenderTarget(noiseTarget, config.width, config.height, GL_RGBA32F) ||
+        !createRenderTarget(sceneTarget, config.width, config.height, GL_RGBA8))
+    {
+        deleteRenderTarget(noiseTarget);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    FullscreenQuad quad = createFullscreenQuad();
+
+    std::cout << "GL_RENDERER" << glGetString(GL_RENDERER) << "\n"
+        << "ϣԱȣ" << config.width << "x" << config.height << "ÿ " << NoiseBenchEvaluations
+        << "  value()" << config.frames << " ֡" << std::endl;
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    size_t pixelCount = static_cast<size_t>(config.width) * config.height;
+    std::vector<unsigned char> reference(pixelCount * 3), pixels(pixelCount * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    int result = 0;
+
+    for (int i = 0; i < NoiseHashCount; i++)
+    {
+        NoiseHash hash = static_cast<NoiseHash>(i);
+        double noiseMs = 0.0;
+        NoiseStats stats;
+        if (!benchNoiseHash(hash, config, vertexSource, fragmentSource, quad, noiseTarget, noiseMs, stats))
+        {
+            std::cout << noiseHashName(hash) << "׼ʧܣ" << std::endl;
+            result = -1;
+            continue;
+        }
+
+        // 棺ѡУֻϣ
+        RenderConfig sceneConfig = config;
+        sceneConfig.noiseHash = hash;
+        BlackholeRenderer renderer;
+        if (!createBlackholeRenderer(renderer, sceneConfig, vertexSource, fragmentSource))
+        {
+            result = -1;
+            continue;
+        }
+        bindRenderTarget(sceneTarget);
+        double sceneMs = measureFrameTimeMs([&](int frame)
+        {
+            drawBlackhole(renderer, config.startTime + frame * config.timeStep, w, h, config.mouseX * w, config.mouseY * h);
+        }, config.frames);
+        drawBlackhole(renderer, config.startTime, w, h, config.mouseX * w, config.mouseY * h);
+        glReadPixels(0, 0, config.width, config.height, GL_RGB, GL_UNSIGNED_BYTE, i == 0 ? reference.data() : pixels.data());
+        deleteBlackholeRenderer(renderer);
+
+        // ͬϣͬǿգֻ˵ж󣬻Ƿȼۿƽ
+        double brightness = 0.0, sum = 0.0;
+        for (size_t p = 0; p < pixelCount * 3; p++)
+        {
+            brightness += i == 0 ? reference[p] : pixels[p];
+            sum += std::abs(static_cast<int>(reference[p]) - static_cast<int>(i == 0 ? reference[p] : pixels[p]));
+        }
+
+        std::cout << noiseHashName(hash) << "value() " << pixelCount * NoiseBenchEvaluations / (noiseMs * 1000.0)
+            << " M/s" << noiseMs << " ms/ֵ֡ " << stats.valueMean << "׼ " << stats.valueStd
+            << "ϣֵ " << stats.hashMean << " " << stats.hashCorrelation
+            << " CPU һ " << 100.0 * stats.hashExact << "% " << stats.hashMaxError << ""
+            << " " << sceneMs << " ms/֡ƽ " << brightness / (pixelCount * 3)
+            << " / 255 sin ƽ " << sum / (pixelCount * 3) << " / 255" << std::endl;
+    }
+
+    deleteFullscreenQuad(quad);
+    deleteRenderTarget(sceneTarget);
+    deleteRenderTarget(noiseTarget);
+    destroyOffscreenContext(ctx);
+    return result;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include "render_config.h"
+
+// ÿֵ value() NOISE_BENCH ꣩
+const int NoiseBenchEvaluations = 64;
+
+// --noise-bench EGL βԸϣˣnoise_hash.h
+// value() ¡ֵͳƷֲϣ CPU οʵǷλһ£
+// Լĺʱ sin ϣĲ
+int runNoiseBenchmark(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
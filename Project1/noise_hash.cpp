@@ -0,0 +1,111 @@
+#include <glad/glad.h>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "noise_hash.h"
+
+static const char* Names[NoiseHashCount] = { "sin", "pcg", "xxhash", "texture" };
+
+const char* noiseHashName(NoiseHash hash)
+{
+    return Names[static_cast<int>(hash)];
+}
+
+bool parseNoiseHash(const std::string& name, NoiseHash& hash)
+{
+    for (int i = 0; i < NoiseHashCount; i++)
+    {
+        if (name == Names[i])
+        {
+            hash = static_cast<NoiseHash>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string noiseHashDefines(NoiseHash hash)
+{
+    switch (hash)
+    {
+    case NoiseHash::Pcg:
+        return "#define NOISE_HASH_PCG\n";
+    case NoiseHash::XxHash:
+        return "#define NOISE_HASH_XXHASH\n";
+    case NoiseHash::Texture:
+        return "#define NOISE_HASH_TEXTURE\n#define NOISE_HASH_TEXTURE_SIZE " + std::to_string(NoiseHashTextureSize) + "\n";
+    default:
+        return "";
+    }
+}
+
+static uint32_t pcgHash(uint32_t v)
+{
+    uint32_t state = v * 747796405u + 2891336453u;
+    uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+static uint32_t xxHash(uint32_t x, uint32_t y)
+{
+    const uint32_t PRIME32_2 = 2246822519u;
+    const uint32_t PRIME32_3 = 3266489917u;
+    const uint32_t PRIME32_4 = 668265263u;
+    const uint32_t PRIME32_5 = 374761393u;
+    uint32_t h32 = y + PRIME32_5 + x * PRIME32_3;
+    h32 = PRIME32_4 * ((h32 << 17) | (h32 >> 15));
+    h32 += y * PRIME32_3;
+    h32 = PRIME32_4 * ((h32 << 17) | (h32 >> 15));
+    h32 = PRIME32_2 * (h32 ^ (h32 >> 15));
+    h32 = PRIME32_3 * (h32 ^ (h32 >> 13));
+    return h32 ^ (h32 >> 16);
+}
+
+static float hashToFloat(uint32_t h)
+{
+    return static_cast<float>(h >> 8) * (1.0f / 16777216.0f);
+}
+
+static float sinHash(float x)
+{
+    float s = std::sin(x) * 152754.742f;
+    return s - std::floor(s);
+}
+
+float noiseHashValue(NoiseHash hash, int x, int y)
+{
+    uint32_t ux = static_cast<uint32_t>(x);
+    uint32_t uy = static_cast<uint32_t>(y);
+    switch (hash)
+    {
+    case NoiseHash::Pcg:
+        return hashToFloat(pcgHash(ux + pcgHash(uy)));
+    case NoiseHash::XxHash:
+        return hashToFloat(xxHash(ux, uy));
+    case NoiseHash::Texture:
+    {
+        const uint32_t mask = NoiseHashTextureSize - 1;
+        return noiseHashValue(NoiseHash::Pcg, static_cast<int>(ux & mask), static_cast<int>(uy & mask));
+    }
+    default:
+        return sinHash(static_cast<float>(x) + sinHash(static_cast<float>(y)));
+    }
+}
+
+unsigned int createNoiseHashTexture()
+{
+    std::vector<float> table(static_cast<size_t>(NoiseHashTextureSize) * NoiseHashTextureSize);
+    for (int y = 0; y < NoiseHashTextureSize; y++)
+        for (int x = 0; x < NoiseHashTextureSize; x++)
+            table[static_cast<size_t>(y) * NoiseHashTextureSize + x] = noiseHashValue(NoiseHash::Pcg, x, y);
+
+    // ɫ texelFetch ȡҪ
+    unsigned int tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, NoiseHashTextureSize, NoiseHashTextureSize, 0, GL_RED, GL_FLOAT, table.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    return tex;
+}
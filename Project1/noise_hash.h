@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+// ֵĸϣˣnoise.glsl еĺ꣬--noise-hash ѡ
+enum class NoiseHash
+{
+    Sin,        // ԭ fract(sin(x) * 152754.742)ȡ sin 
+    Pcg,        // PCG ϣ
+    XxHash,     // xxHash32
+    Texture,    //  PCG ϣiChannel0
+};
+const int NoiseHashCount = 4;
+
+// Texture ˵Ĺϣ߳2 ݣ갴ѭ
+const int NoiseHashTextureSize = 1024;
+
+const char* noiseHashName(NoiseHash hash);
+// ƣsin/pcg/xxhash/textureʧʱ false
+bool parseNoiseHash(const std::string& name, NoiseHash& hash);
+// ע #version ֮ĺ궨飨Sin Ϊգ
+std::string noiseHashDefines(NoiseHash hash);
+
+//  noise.glsl ͬĸϣCPU οʵ֣ GPU λһ£
+// Sin  float ȼ㣬 GPU Ĳ sin ʵ
+float noiseHashValue(NoiseHash hash, int x, int y);
+
+//  Texture ˵ĹϣNoiseHashTextureSize^2  R32F  (i, j) Ϊ PCG ˵Ĺϣֵ
+unsigned int createNoiseHashTexture();
@@ -0,0 +1,145 @@
+#include <glad/glad.h>
+#include <iostream>
+#include <cstring>
+#include "offscreen_context.h"
+#include "program_cache.h"
+
+#ifdef _WIN32
+
+bool createOffscreenContext(OffscreenContext& ctx)
+{
+    std::cout << "Ⱦ֧ LinuxEGL" << std::endl;
+    return false;
+}
+
+bool makeOffscreenContextCurrent(const OffscreenContext& ctx)
+{
+    return false;
+}
+
+void destroyOffscreenContext(OffscreenContext& ctx)
+{
+}
+
+#else
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <mutex>
+
+// ͬһڵĹһ EGLDisplayeglInitialize/eglTerminate 
+// κһʱ eglTerminate ʹ߳ϵʧЧԼһʱֹ
+// ̣ GLAD ȫָֺ룩Ҳڴн
+static std::mutex displayMutex;
+static int displayUsers = 0;
+
+// ʹ Mesa  surfaceless ƽ̨ X11/Wayland/GPU 豸
+static EGLDisplay getSurfacelessDisplay()
+{
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (extensions && strstr(extensions, "EGL_MESA_platform_surfaceless"))
+    {
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay)
+        {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+            if (display != EGL_NO_DISPLAY)
+                return display;
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+// һʹֹ߲ʾӣ߳ displayMutex
+static void releaseDisplay(EGLDisplay display)
+{
+    if (--displayUsers == 0)
+        eglTerminate(display);
+}
+
+bool createOffscreenContext(OffscreenContext& ctx)
+{
+    std::lock_guard<std::mutex> lock(displayMutex);
+    EGLDisplay display = getSurfacelessDisplay();
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+    {
+        std::cout << "EGL ʼʧܣ" << std::endl;
+        return false;
+    }
+    displayUsers++;
+
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (!extensions || !strstr(extensions, "EGL_KHR_surfaceless_context"))
+    {
+        std::cout << "EGL ֧ EGL_KHR_surfaceless_context" << std::endl;
+        releaseDisplay(display);
+        return false;
+    }
+
+    // ֻȾ FBOòҪκα
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, 0,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0)
+    {
+        std::cout << "EGL Ҳã" << std::endl;
+        releaseDisplay(display);
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT)
+    {
+        std::cout << "EGL  OpenGL 3.3 Core ʧܣ" << std::endl;
+        releaseDisplay(display);
+        return false;
+    }
+
+    ctx.display = display;
+    ctx.context = context;
+    //  GLAD
+    if (!makeOffscreenContextCurrent(ctx) || !gladLoadGLLoader((GLADloadproc)eglGetProcAddress))
+    {
+        std::cout << "EGL İ󶨻 GLAD ʧܣ" << std::endl;
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+        releaseDisplay(display);
+        ctx = OffscreenContext();
+        return false;
+    }
+    loadProgramCacheFunctions((GLADloadproc)eglGetProcAddress);
+    return true;
+}
+
+bool makeOffscreenContextCurrent(const OffscreenContext& ctx)
+{
+    return eglMakeCurrent((EGLDisplay)ctx.display, EGL_NO_SURFACE, EGL_NO_SURFACE, (EGLContext)ctx.context) == EGL_TRUE;
+}
+
+void destroyOffscreenContext(OffscreenContext& ctx)
+{
+    if (ctx.display)
+    {
+        eglMakeCurrent((EGLDisplay)ctx.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (ctx.context)
+            eglDestroyContext((EGLDisplay)ctx.display, (EGLContext)ctx.context);
+        eglReleaseThread();
+        std::lock_guard<std::mutex> lock(displayMutex);
+        releaseDisplay((EGLDisplay)ctx.display);
+    }
+    ctx = OffscreenContext();
+}
+
+#endif
@@ -0,0 +1,14 @@
+#pragma once
+
+// ޴ OpenGL 3.3 Core ģEGL surfaceless Mesa llvmpipe
+struct OffscreenContext
+{
+    void* display = nullptr;  // EGLDisplay
+    void* context = nullptr;  // EGLContext
+};
+
+// ĲΪǰ̵߳ĵǰģͬʱ GLAD
+// ڶ߳ϸһģٶ̰߳ȫ
+bool createOffscreenContext(OffscreenContext& ctx);
+bool makeOffscreenContextCurrent(const OffscreenContext& ctx);
+void destroyOffscreenContext(OffscreenContext& ctx);
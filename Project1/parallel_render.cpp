@@ -0,0 +1,192 @@
+#include <glad/glad.h>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "parallel_render.h"
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Ⱦ̹߳߳Ż
+struct FrameReorder
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::map<int, std::vector<unsigned char>> ready;    // Ѷءȴ򽻸֡
+    std::vector<std::vector<unsigned char>> spare;
+    int nextIndex = 0;      // һ֡Ҫ֡
+    int window = 0;         // Ⱦ߳̿ nextIndex ֡
+    int readyThreads = 0;
+    bool aborted = false;   // ߳ʧܻ consumer Ҫֹͣ
+    double aheadWaitMs = 0.0;
+};
+
+// ȾڼҪӻس򡢺決ұ򻺴ͳƺļ̰߳ȫģд
+static std::mutex setupMutex;
+
+static void abortReorder(FrameReorder& reorder)
+{
+    std::lock_guard<std::mutex> lock(reorder.mutex);
+    reorder.aborted = true;
+    reorder.changed.notify_all();
+}
+
+static void renderThread(const RenderConfig& config, const char* vertexSource, const char* fragmentSource,
+    int thread, int contexts, int first, int frames, const FrameTimeFunction& timeOf, FrameReorder& reorder,
+    int& rendered)
+{
+    OffscreenContext ctx;
+    BlackholeRenderer renderer;
+    RenderTarget target;
+    bool created = false;
+    {
+        std::lock_guard<std::mutex> lock(setupMutex);
+        if (createOffscreenContext(ctx))
+        {
+            created = createBlackholeRenderer(renderer, config, vertexSource, fragmentSource);
+            if (created && !createRenderTarget(target, config.width, config.height, GL_RGBA8))
+            {
+                deleteBlackholeRenderer(renderer);
+                created = false;
+            }
+            if (!created)
+                destroyOffscreenContext(ctx);
+        }
+    }
+    // 
+    if (!created)
+    {
+        std::cout << "Ⱦ߳ " << thread << " ʼʧܣ" << std::endl;
+        abortReorder(reorder);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(reorder.mutex);
+        reorder.readyThreads++;
+        reorder.changed.notify_all();
+    }
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    size_t frameSize = static_cast<size_t>(config.width) * config.height * 3;
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    for (int index = first + thread; index < first + frames; index += contexts)
+    {
+        std::vector<unsigned char> pixels;
+        {
+            std::unique_lock<std::mutex> lock(reorder.mutex);
+            if (index >= reorder.nextIndex + reorder.window && !reorder.aborted)
+            {
+                auto start = Clock::now();
+                reorder.changed.wait(lock, [&]() { return index < reorder.nextIndex + reorder.window || reorder.aborted; });
+                reorder.aheadWaitMs += elapsedMs(start);
+            }
+            if (reorder.aborted)
+                break;
+            if (!reorder.spare.empty())
+            {
+                pixels = std::move(reorder.spare.back());
+                reorder.spare.pop_back();
+            }
+        }
+        pixels.resize(frameSize);
+
+        bindRenderTarget(target);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawBlackhole(renderer, timeOf(index), w, h, config.mouseX * w, config.mouseY * h);
+        glReadPixels(0, 0, config.width, config.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        rendered++;
+
+        std::lock_guard<std::mutex> lock(reorder.mutex);
+        reorder.ready.emplace(index, std::move(pixels));
+        reorder.changed.notify_all();
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    deleteRenderTarget(target);
+    deleteBlackholeRenderer(renderer);
+    destroyOffscreenContext(ctx);
+}
+
+bool renderFramesParallel(const RenderConfig& config, const char* vertexSource, const char* fragmentSource,
+    int contexts, int first, int frames, const FrameTimeFunction& timeOf, const OrderedFrameConsumer& consumer,
+    ParallelRenderStats& stats)
+{
+    RenderConfig threadConfig = config;
+    if (threadConfig.taa)
+    {
+        std::cout << "Ⱦʱÿֻ߳Ⱦ֡ --taa" << std::endl;
+        threadConfig.taa = false;
+    }
+
+    FrameReorder reorder;
+    reorder.nextIndex = first;
+    reorder.window = 2 * contexts;
+    stats = ParallelRenderStats();
+    stats.framesPerContext.assign(contexts, 0);
+
+    auto setupStart = Clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < contexts; t++)
+        threads.emplace_back(renderThread, std::cref(threadConfig), vertexSource, fragmentSource, t, contexts, first, frames,
+            std::cref(timeOf), std::ref(reorder), std::ref(stats.framesPerContext[t]));
+    {
+        std::unique_lock<std::mutex> lock(reorder.mutex);
+        reorder.changed.wait(lock, [&]() { return reorder.readyThreads == contexts || reorder.aborted; });
+    }
+    stats.setupMs = elapsedMs(setupStart);
+
+    auto renderStart = Clock::now();
+    bool ok = true;
+    for (int index = first; index < first + frames; index++)
+    {
+        std::vector<unsigned char> pixels;
+        {
+            std::unique_lock<std::mutex> lock(reorder.mutex);
+            auto start = Clock::now();
+            reorder.changed.wait(lock, [&]() { return reorder.ready.count(index) > 0 || reorder.aborted; });
+            stats.consumerWaitMs += elapsedMs(start);
+            if (reorder.aborted)
+            {
+                ok = false;
+                break;
+            }
+            pixels = std::move(reorder.ready[index]);
+            reorder.ready.erase(index);
+        }
+
+        bool accepted = consumer(index, pixels.data());
+
+        std::lock_guard<std::mutex> lock(reorder.mutex);
+        reorder.spare.push_back(std::move(pixels));
+        reorder.nextIndex = index + 1;
+        reorder.changed.notify_all();
+        if (!accepted)
+        {
+            reorder.aborted = true;
+            ok = false;
+            break;
+        }
+    }
+    stats.renderMs = elapsedMs(renderStart);
+
+    if (!ok)
+        abortReorder(reorder);
+    for (std::thread& thread : threads)
+        thread.join();
+    stats.aheadWaitMs = reorder.aheadWaitMs;
+    return ok;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include "render_config.h"
+
+// ֡˳򽻸һ֡RGB 8 λglReadPixels ¶ϣָֻڻصڼЧ false ʱֹͣȾ
+using OrderedFrameConsumer = std::function<bool(int index, const unsigned char* rgb)>;
+// ֡ -> iTime
+using FrameTimeFunction = std::function<float(int index)>;
+
+struct ParallelRenderStats
+{
+    double setupMs = 0.0;               // ̴߳ȾУʱ
+    double renderMs = 0.0;              // һ߳̾һ֡
+    double consumerWaitMs = 0.0;        // ̵߳ȴһ֡ʱ䣨Ⱦϣ
+    double aheadWaitMs = 0.0;           // Ⱦ̫߳ȴʱ䣨Ѹϣ
+    std::vector<int> framesPerContext;
+};
+
+// һڵĶĲȾcontexts  EGL ĸһ߳ϣ
+// ÿ̴߳ԼȾɫһΣ߳ t Ⱦ֡ first + tfirst + t + contexts
+// ص֡֡źڵ߳ν consumer
+// Ⱦ߳һ֡ 2 * contexts ֡ڴռޡTAA ʷ̲֡߳ᱻر
+bool renderFramesParallel(const RenderConfig& config, const char* vertexSource, const char* fragmentSource,
+    int contexts, int first, int frames, const FrameTimeFunction& timeOf, const OrderedFrameConsumer& consumer,
+    ParallelRenderStats& stats);
@@ -0,0 +1,224 @@
+#include <glad/glad.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "program_cache.h"
+#include "shader_program.h"
+
+static std::string cacheDirectory = "shader_cache";
+static ProgramCacheStats stats;
+
+static double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 벢ͳ
+static unsigned int compileProgram(const char* vertexSource, const char* fragmentSource, bool retrievable)
+{
+    auto start = std::chrono::steady_clock::now();
+    unsigned int program = createShaderProgram(vertexSource, fragmentSource, retrievable);
+    if (program != 0)
+    {
+        stats.compiled++;
+        stats.compileMs += elapsedMs(start);
+    }
+    return program;
+}
+
+void setProgramCacheDirectory(const std::string& directory)
+{
+    cacheDirectory = directory;
+}
+
+ProgramCacheStats programCacheStats()
+{
+    return stats;
+}
+
+// Ƿṩĳչģʽѯ
+static bool hasExtension(const char* name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++)
+    {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && std::strcmp(extension, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+void loadProgramCacheFunctions(void* (*load)(const char* name))
+{
+    // GL 4.1 ΪĹܣglad Ѱİ汾
+    if (glGetProgramBinary && glProgramBinary && glProgramParameteri)
+        return;
+    // Ͱ汾ͨչṩͬglad.c δɸչͬһغ
+    if (!hasExtension("GL_ARB_get_program_binary"))
+        return;
+    glad_glGetProgramBinary = reinterpret_cast<PFNGLGETPROGRAMBINARYPROC>(load("glGetProgramBinary"));
+    glad_glProgramBinary = reinterpret_cast<PFNGLPROGRAMBINARYPROC>(load("glProgramBinary"));
+    glad_glProgramParameteri = reinterpret_cast<PFNGLPROGRAMPARAMETERIPROC>(load("glProgramParameteri"));
+}
+
+// ļͷ
+static const char CacheMagic[4] = { 'G', 'L', 'P', 'B' };
+struct CacheHeader
+{
+    char magic[4];
+    uint32_t format;    // glGetProgramBinary صĶƸʽ
+    uint32_t length;    // ֽ
+    uint64_t key;       // ļͬļֹϣǰ׺ײļ
+};
+
+// FNV-1a 64 λϣ֮ 0 ָ
+static uint64_t hashString(uint64_t hash, const char* text)
+{
+    for (const char* p = text; ; p++)
+    {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= 1099511628211ull;
+        if (*p == '\0')
+            return hash;
+    }
+}
+
+static uint64_t programKey(const char* vertexSource, const char* fragmentSource)
+{
+    uint64_t hash = 14695981039346656037ull;
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    hash = hashString(hash, vertexSource);
+    return hashString(hash, fragmentSource);
+}
+
+static std::string cachePath(uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return cacheDirectory + "/" + name;
+}
+
+// Ƿ֧һֳƸʽ Mesa رմ̻ʱΪ 0
+static bool binarySupported()
+{
+    if (!glGetProgramBinary || !glProgramBinary || !glProgramParameteri)
+        return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+static unsigned int loadProgramBinary(const std::string& path, uint64_t key)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return 0;
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0);
+
+    CacheHeader header;
+    std::vector<char> binary;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::char_traits<char>::compare(header.magic, CacheMagic, 4) != 0 || header.key != key)
+        return 0;
+    // ȱļʣֽһ£ضϻ𻵵ļͷеĳȷڴ
+    if (header.length == 0 || static_cast<std::streamoff>(header.length) != fileSize - static_cast<std::streamoff>(sizeof(header)))
+        return 0;
+    binary.resize(header.length);
+    if (!file.read(binary.data(), binary.size()))
+        return 0;
+
+    unsigned int program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    // Ʋʱ״̬Ϊʧܣɵ߻˵
+    int success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+static void saveProgramBinary(unsigned int program, const std::string& path, uint64_t key)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, NULL, &format, binary.data());
+
+#ifdef _WIN32
+    _mkdir(cacheDirectory.c_str());
+    int pid = _getpid();
+#else
+    mkdir(cacheDirectory.c_str(), 0755);
+    int pid = getpid();
+#endif
+    // дʱļٸͬʱʱдһļ
+    // ʱļ̺źͽţͬʱдͬһḶ̡̌߳ũ̡ģ
+    static std::atomic<unsigned int> temporaryCounter(0);
+    std::string temporary = path + "." + std::to_string(pid) + "." + std::to_string(temporaryCounter++) + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        CacheHeader header = { { CacheMagic[0], CacheMagic[1], CacheMagic[2], CacheMagic[3] },
+            format, static_cast<uint32_t>(length), key };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), binary.size());
+        // 
+        if (!file)
+        {
+            std::cout << "ƻдʧܣ" << temporary << std::endl;
+            file.close();
+            std::remove(temporary.c_str());
+            return;
+        }
+    }
+    std::remove(path.c_str());
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+        std::remove(temporary.c_str());
+}
+
+unsigned int createCachedShaderProgram(const char* vertexSource, const char* fragmentSource)
+{
+    if (cacheDirectory.empty() || !binarySupported())
+        return compileProgram(vertexSource, fragmentSource, false);
+
+    uint64_t key = programKey(vertexSource, fragmentSource);
+    std::string path = cachePath(key);
+
+    auto start = std::chrono::steady_clock::now();
+    unsigned int program = loadProgramBinary(path, key);
+    if (program != 0)
+    {
+        stats.loaded++;
+        stats.loadMs += elapsedMs(start);
+        return program;
+    }
+
+    program = compileProgram(vertexSource, fragmentSource, true);
+    if (program != 0)
+        saveProgramBinary(program, path, key);
+    return program;
+}
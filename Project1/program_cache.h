@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+
+// ɫƵĴ̻棨GL 4.1 Ļ GL_ARB_get_program_binary
+// Ϊ GL /Ⱦ/汾ַԴ루עĺ꣩Ĺϣ
+// ʱ glProgramBinary ֱӼأļ𻵡ܾʱ˵벢д
+struct ProgramCacheStats
+{
+    int loaded = 0;         // ӻصĳ
+    int compiled = 0;       // ԴĳδСܾ򻺴رգ
+    double loadMs = 0.0;
+    double compileMs = 0.0;
+};
+
+//  gladLoadGLLoader ֮ͬһغãĵ GL 4.1 ʱ glad سƺ
+// ṩ GL_ARB_get_program_binary ء߶ûʱرգʼմԴ
+void loadProgramCacheFunctions(void* (*load)(const char* name));
+
+// Ŀ¼ַʾرջ棨Ĭ "shader_cache"
+void setProgramCacheDirectory(const std::string& directory);
+
+//  createShaderProgram ͬȴӻأʧʱ 0
+unsigned int createCachedShaderProgram(const char* vertexSource, const char* fragmentSource);
+
+// ڵͳ
+ProgramCacheStats programCacheStats();
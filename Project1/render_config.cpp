@@ -0,0 +1,335 @@
+#include "render_config.h"
+#include "frame_capture.h"
+#include "image_write.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+static void printUsage(const char* exe)
+{
+    std::cout << "÷" << exe << " [ѡ]\n"
+        << "  --headless            ޴ȾEGL surfaceless llvmpipe У\n"
+        << "  --cpu                  CPUSIMD + ̣߳ȾдļҪ OpenGL\n"
+        << "  --cpu-bench           CPU Ⱦ²ԣ߳ Mpixels/s\n"
+        << "  --cpu-compare         CPU  GLSLEGLȾһ֡Ƚ\n"
+        << "  --bench               ɫ GPU ʱԱȣԭʼѭ / ͸ұ / ͼ\n"
+        << "  --noise-bench         ϣ˶Աȣvalue() ¡ͳԡ CPU οʵּԭʼĲ\n"
+        << "  --still <n>           ۻ̶֡ iTime/iMouseÿۻ n дļ\n"
+        << "  --still-seconds <s>   ֡ʱԤ㣬ȵԤ㼴ֹͣĬϲޣ\n"
+        << "  --still-preview <n>   ֡ÿۻ n дһмĬֻдս\n"
+        << "  --still-tile <n>      ֡ n x n ĿȾʽдļ߷ֱʣ 16384x8192\n"
+        << "  --capture-bench       ֡ؿԱȣ / ÿ֡ͬ glReadPixels / PBO 첽\n"
+        << "  --export <file>       ̶ȾƵԭʼ֡ܵ͸̣Ĭ ffmpeg / libx264\n"
+        << "  --fps <n>             ֡ʣiTime ÿ֡ȷƽ 1/nĬ 60\n"
+        << "  --duration <s>        ʱ룩 --frames\n"
+        << "  --encoder <cmd>       ӱ׼ rgb24 ԭʼ֡{width} {height} {fps} {output} ᱻ滻\n"
+        << "  --export-queue <n>    ֮н֡Ĭ 8\n"
+        << "  --contexts <k>        ޴ / ģʽ k  EGL  k ߳ϲȾ֡\n"
+        << "  --contexts-bench      ²ԣ 124  --contextsĬӲ߳\n"
+        << "  --serve <socket>      פȾ Unix ׽Ͻ render 󣬻ظ PPM ͼ\n"
+        << "  --max-batch <n>       ȾÿϲĬ 16\n"
+        << "  --batch-window <ms>   Ⱦȡȴʱ䣨Ĭ 0 = ֻϲŶӵģ\n"
+        << "  --load-test <socket>  Ⱦѹԣ/s ӳٷλ\n"
+        << "  --clients <n>         ѹԵĲĬ 8\n"
+        << "  --requests <n>        ѹÿӵĬ 16\n"
+        << "  --views <n>           ͼͼͬһ iTime  n ǵͼÿ --width x --heightһʵ\n"
+        << "  --views-compare       ͼģʽͬʱͼƣȽϺʱز\n"
+        << "  --farm <n>            Ⱦũ֡гҵļУڱ n \n"
+        << "  --farm-worker         ֻΪ̴ --farm-dir ȡҵũʱʹã\n"
+        << "  --farm-dir <dir>      ҵĿ¼Ĭ farm̨ʱڹļϵͳϣ\n"
+        << "  --chunk <n>           ÿҵ֡Ĭ 8\n"
+        << "  --farm-retries <n>    ҵŻضеĬ 2\n"
+        << "  --farm-lease <s>      ҵԼȡ߳ s ûһ֡ΪĬ 300\n"
+        << "  --quality <q>          low / medium / high / ultraĬ high\n"
+        << "  --lensing-lut         Ԥ͸ұѭ\n"
+        << "  --taa                 ʱ俹ݣÿ֡һߣͶӰʷ֡\n"
+        << "  --geodesic-cache      ʱò G-bufferÿֻ֡ɫ\n"
+        << "  --adaptive <2|4>      ֲֻԲƽĿ׷٣ֵ\n"
+        << "  --adaptive-threshold <t>  ӦϸɫֵĬ 0.03\n"
+        << "  --analytic-crossing   潻㰴 pos.y ŽСƽ\n"
+        << "  --rk45                ӦDormand-Prince 5(4)ÿƵ\n"
+        << "  --rk-tolerance <e>    ӦÿޣĬ 1e-4\n"
+        << "  --weak-field          ľĹ߰ƫ۽ǣ˹̹ + \n"
+        << "  --count-steps         ͳÿ֡ÿߵƽֲ\n"
+        << "  --tile-classify       Ƭࣨ /  / ӽ磩ÿȥ޹ط֧ĳ\n"
+        << "  --disk-noise-texture  Ϊʱ決ĸӲ˫Բֵ\n"
+        << "  --noise-hash <h>      ֵĸϣ sin / pcg / xxhash / textureĬ sin\n"
+        << "  --background-cubemap <n>  Ԥ決ÿ n صͼ 1024\n"
+        << "  --profile             ÿȾ pass  GPU ʱѯʱ֡ʱ p50/p95/p99\n"
+        << "  --profile-csv <file>  ͬ --profile֡д CSV\n"
+        << "  --dynamic-resolution <ms>   GPU ʱȾֱʣʹ֡ʱӽԤ\n"
+        << "  --scale-range <min> <max>  ֱ̬ʵȾΧĬ 0.25 1\n"
+        << "  --scale-hysteresis <h>     ʱԤ +-h ڲĬ 0.1\n"
+        << "  --sharpen <s>         ֱ̬ʷŴʱǿȣĬ 0 = ˫ԣ\n"
+        << "  --capture-ring <n>    ޴ģʽ n  PBO Ļ첽֡1 ~ 8Ĭ 0 = ͬأ\n"
+        << "  --capture             ģʽÿһ֡첽زд --outputPBO Ĭ 3 \n"
+        << "  --program-cache <dir> ƻĿ¼Ĭ shader_cache\n"
+        << "  --no-program-cache    ÿԴɫ\n"
+        << "  --threads <n>         CPU Ⱦ߳Ĭ 0 = ȫӲ̣߳\n"
+        << "  --width <w>           ȣĬ 800\n"
+        << "  --height <h>          ߶ȣĬ 600\n"
+        << "  --frames <n>          Ⱦ֡Ĭ 1\n"
+        << "  --start-frame <n>     һ֡ȫ֡ţiTime ļȫ֡ţĬ 0\n"
+        << "  --time <t>            ʼ iTimeĬ 0\n"
+        << "  --dt <t>              ÿ֡ iTime Ĭ 1/60\n"
+        << "  --mouse <x> <y>       һλãĬ 0 0\n"
+        << "  --output <pattern>    ļģ壬һ %d  %0Nd ֡ţĬ frame_%04d.ppm\n";
+}
+
+bool parseRenderConfig(int argc, char** argv, RenderConfig& config)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        // Ƿ n ֵ
+        auto hasValues = [&](int n) { return i + n < argc; };
+
+        try
+        {
+            if (arg == "--headless")
+                config.mode = RenderMode::Headless;
+            else if (arg == "--cpu")
+                config.mode = RenderMode::Cpu;
+            else if (arg == "--cpu-bench")
+                config.mode = RenderMode::CpuBench;
+            else if (arg == "--cpu-compare")
+                config.mode = RenderMode::CpuCompare;
+            else if (arg == "--bench")
+                config.mode = RenderMode::Bench;
+            else if (arg == "--noise-bench")
+                config.mode = RenderMode::NoiseBench;
+            else if (arg == "--still" && hasValues(1))
+            {
+                config.mode = RenderMode::Still;
+                config.stillSamples = std::stoi(argv[++i]);
+            }
+            else if (arg == "--still-seconds" && hasValues(1))
+                config.stillSeconds = std::stof(argv[++i]);
+            else if (arg == "--still-preview" && hasValues(1))
+                config.stillPreview = std::stoi(argv[++i]);
+            else if (arg == "--still-tile" && hasValues(1))
+                config.stillTile = std::stoi(argv[++i]);
+            else if (arg == "--export" && hasValues(1))
+            {
+                config.mode = RenderMode::Export;
+                config.exportPath = argv[++i];
+            }
+            else if (arg == "--fps" && hasValues(1))
+                config.exportFps = std::stoi(argv[++i]);
+            else if (arg == "--duration" && hasValues(1))
+                config.exportSeconds = std::stof(argv[++i]);
+            else if (arg == "--encoder" && hasValues(1))
+                config.exportEncoder = argv[++i];
+            else if (arg == "--export-queue" && hasValues(1))
+                config.exportQueue = std::stoi(argv[++i]);
+            else if (arg == "--contexts" && hasValues(1))
+                config.contexts = std::stoi(argv[++i]);
+            else if (arg == "--contexts-bench")
+                config.mode = RenderMode::ContextBench;
+            else if (arg == "--serve" && hasValues(1))
+            {
+                config.mode = RenderMode::Serve;
+                config.serveSocket = argv[++i];
+            }
+            else if (arg == "--max-batch" && hasValues(1))
+                config.serveMaxBatch = std::stoi(argv[++i]);
+            else if (arg == "--batch-window" && hasValues(1))
+                config.serveBatchWindow = std::stof(argv[++i]);
+            else if (arg == "--load-test" && hasValues(1))
+            {
+                config.mode = RenderMode::LoadTest;
+                config.serveSocket = argv[++i];
+            }
+            else if (arg == "--clients" && hasValues(1))
+                config.loadClients = std::stoi(argv[++i]);
+            else if (arg == "--requests" && hasValues(1))
+                config.loadRequests = std::stoi(argv[++i]);
+            else if (arg == "--views" && hasValues(1))
+            {
+                config.mode = RenderMode::MultiView;
+                config.views = std::stoi(argv[++i]);
+            }
+            else if (arg == "--views-compare")
+                config.viewsCompare = true;
+            else if (arg == "--farm" && hasValues(1))
+            {
+                config.mode = RenderMode::Farm;
+                config.farmWorkers = std::stoi(argv[++i]);
+            }
+            else if (arg == "--farm-worker")
+                config.mode = RenderMode::FarmWorker;
+            else if (arg == "--farm-dir" && hasValues(1))
+                config.farmDir = argv[++i];
+            else if (arg == "--chunk" && hasValues(1))
+                config.farmChunk = std::stoi(argv[++i]);
+            else if (arg == "--farm-retries" && hasValues(1))
+                config.farmRetries = std::stoi(argv[++i]);
+            else if (arg == "--farm-lease" && hasValues(1))
+                config.farmLease = std::stoi(argv[++i]);
+            else if (arg == "--capture-bench")
+                config.mode = RenderMode::CaptureBench;
+            else if (arg == "--quality" && hasValues(1))
+            {
+                if (!parseShaderQuality(argv[++i], config.quality))
+                {
+                    std::cout << "δ֪ʣ" << argv[i] << std::endl;
+                    printUsage(argv[0]);
+                    return false;
+                }
+            }
+            else if (arg == "--lensing-lut")
+                config.lensingLut = true;
+            else if (arg == "--taa")
+                config.taa = true;
+            else if (arg == "--geodesic-cache")
+                config.geodesicCache = true;
+            else if (arg == "--adaptive" && hasValues(1))
+                config.adaptiveBlock = std::stoi(argv[++i]);
+            else if (arg == "--adaptive-threshold" && hasValues(1))
+                config.adaptiveThreshold = std::stof(argv[++i]);
+            else if (arg == "--analytic-crossing")
+                config.analyticCrossing = true;
+            else if (arg == "--rk45")
+                config.rk45 = true;
+            else if (arg == "--rk-tolerance" && hasValues(1))
+                config.rkTolerance = std::stof(argv[++i]);
+            else if (arg == "--weak-field")
+                config.weakField = true;
+            else if (arg == "--count-steps")
+                config.countSteps = true;
+            else if (arg == "--tile-classify")
+                config.tileClassify = true;
+            else if (arg == "--disk-noise-texture")
+                config.diskNoiseTexture = true;
+            else if (arg == "--noise-hash" && hasValues(1))
+            {
+                if (!parseNoiseHash(argv[++i], config.noiseHash))
+                {
+                    std::cout << "δ֪ϣ" << argv[i] << std::endl;
+                    printUsage(argv[0]);
+                    return false;
+                }
+            }
+            else if (arg == "--background-cubemap" && hasValues(1))
+                config.backgroundCubemap = std::stoi(argv[++i]);
+            else if (arg == "--profile")
+                config.profile = true;
+            else if (arg == "--profile-csv" && hasValues(1))
+            {
+                config.profile = true;
+                config.profileCsv = argv[++i];
+            }
+            else if (arg == "--dynamic-resolution" && hasValues(1))
+                config.dynamicResolution = std::stof(argv[++i]);
+            else if (arg == "--scale-range" && hasValues(2))
+            {
+                config.minScale = std::stof(argv[++i]);
+                config.maxScale = std::stof(argv[++i]);
+            }
+            else if (arg == "--scale-hysteresis" && hasValues(1))
+                config.scaleHysteresis = std::stof(argv[++i]);
+            else if (arg == "--sharpen" && hasValues(1))
+                config.upscaleSharpness = std::stof(argv[++i]);
+            else if (arg == "--capture-ring" && hasValues(1))
+                config.captureRing = std::stoi(argv[++i]);
+            else if (arg == "--capture")
+                config.capture = true;
+            else if (arg == "--program-cache" && hasValues(1))
+                config.programCache = argv[++i];
+            else if (arg == "--no-program-cache")
+                config.programCache.clear();
+            else if (arg == "--threads" && hasValues(1))
+                config.threads = std::stoi(argv[++i]);
+            else if (arg == "--width" && hasValues(1))
+                config.width = std::stoi(argv[++i]);
+            else if (arg == "--height" && hasValues(1))
+                config.height = std::stoi(argv[++i]);
+            else if (arg == "--frames" && hasValues(1))
+                config.frames = std::stoi(argv[++i]);
+            else if (arg == "--start-frame" && hasValues(1))
+                config.startFrame = std::stoi(argv[++i]);
+            else if (arg == "--time" && hasValues(1))
+                config.startTime = std::stof(argv[++i]);
+            else if (arg == "--dt" && hasValues(1))
+                config.timeStep = std::stof(argv[++i]);
+            else if (arg == "--mouse" && hasValues(2))
+            {
+                config.mouseX = std::stof(argv[++i]);
+                config.mouseY = std::stof(argv[++i]);
+            }
+            else if (arg == "--output" && hasValues(1))
+                config.output = argv[++i];
+            else
+            {
+                std::cout << "δ֪ȱٲֵ" << arg << std::endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        }
+        catch (std::exception&)
+        {
+            std::cout << "ֵЧ" << arg << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if (config.width <= 0 || config.height <= 0 || config.frames <= 0 || config.threads < 0 || config.backgroundCubemap < 0)
+    {
+        std::cout << "ֱʡ֡Ϊ߳ͼߴ粻Ϊ" << std::endl;
+        return false;
+    }
+    if (config.adaptiveBlock != 0 && config.adaptiveBlock != 2 && config.adaptiveBlock != 4)
+    {
+        std::cout << "ӦϸĿСֻ 2  4" << std::endl;
+        return false;
+    }
+    if ((config.mode == RenderMode::Still && config.stillSamples <= 0) || config.stillSeconds < 0.0f || config.stillPreview < 0 ||
+        config.stillTile < 0)
+    {
+        std::cout << "֡ΪʱԤ㡢Ԥֿ߳Ϊ" << std::endl;
+        return false;
+    }
+    if (config.captureRing < 0 || config.captureRing > FrameCaptureMaxRing)
+    {
+        std::cout << "ػ PBO  0 ~ " << FrameCaptureMaxRing << " ֮" << std::endl;
+        return false;
+    }
+    if (config.exportFps <= 0 || config.exportSeconds < 0.0f || config.exportQueue <= 0)
+    {
+        std::cout << "֡ʡ֡ΪʱΪ" << std::endl;
+        return false;
+    }
+    if (config.serveMaxBatch <= 0 || config.serveBatchWindow < 0.0f || config.loadClients <= 0 || config.loadRequests <= 0)
+    {
+        std::cout << "ÿÿӵΪڲΪ" << std::endl;
+        return false;
+    }
+    if (config.contexts <= 0)
+    {
+        std::cout << "Ϊ" << std::endl;
+        return false;
+    }
+    if ((config.mode == RenderMode::Farm && config.farmWorkers <= 0) || config.farmChunk <= 0 || config.farmRetries < 0 ||
+        config.farmLease <= 0 || config.startFrame < 0)
+    {
+        std::cout << "ÿҵ֡ԼΪԴʼ֡ŲΪ" << std::endl;
+        return false;
+    }
+    if (config.rkTolerance <= 0.0f)
+    {
+        std::cout << "ӦޱΪ" << std::endl;
+        return false;
+    }
+    if (config.minScale <= 0.0f || config.minScale > config.maxScale || config.scaleHysteresis < 0.0f)
+    {
+        std::cout << "ȾΧЧҪ 0 < min <= maxΪ" << std::endl;
+        return false;
+    }
+    if (!validFramePattern(config.output))
+    {
+        std::cout << "ļģǡúһ֡ռλ %d  %0Ndλ % д %%" << config.output << std::endl;
+        return false;
+    }
+    return true;
+}
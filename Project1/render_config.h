@@ -0,0 +1,92 @@
+#pragma once
+#include <string>
+#include "shader_quality.h"
+#include "noise_hash.h"
+
+// ģʽ
+enum class RenderMode
+{
+    Window,         // GLFW ڽĬϣ
+    Headless,       // ޴ȾEGL
+    Cpu,            // CPU Ⱦдļ
+    CpuBench,       // CPU Ⱦ߳
+    CpuCompare,     // CPU  GLSL Ա
+    Bench,          // ɫ GPU ʱԱȣEGL 
+    NoiseBench,     // ϣ˵뻭ԱȣEGL 
+    Still,          // ۻĸ֡EGL 
+    CaptureBench,   // ֡ؿԱȣ / ͬ glReadPixels / PBO EGL 
+    ContextBench,   // ĲȾı仯EGL 
+    Export,         // ̶Ⱦܵ͸̵ƵEGL 
+    Farm,           // ȾũЭ̣֡гҵļУ
+    FarmWorker,     // Ⱦụ̃ļȡҵȾEGL 
+    Serve,          // פȾ Unix ׽Ͻ󣬻ظͼEGL 
+    LoadTest,       // ȾĲѹԿͻ
+    MultiView,      // ͬһ iTime ¶ͼһλƳͼEGL 
+};
+
+// Ⱦн
+struct RenderConfig
+{
+    RenderMode mode = RenderMode::Window;
+    int width = 800;                // ֱ
+    int height = 600;
+    int frames = 1;                 // Ⱦ֡
+    int startFrame = 0;             // һ֡ȫ֡ţiTime ļȫ֡ţ
+    float startTime = 0.0f;         // һ֡ iTime
+    float timeStep = 1.0f / 60.0f;  // ÿ֡ iTime ģʽ̶
+    float mouseX = 0.0f;            // λãһ
+    float mouseY = 0.0f;
+    ShaderQuality quality = ShaderQuality::High; // ʵλѭAA ȱں꣩
+    bool allQualities = false;      // Ԥȱȫʱ壨ģʽ 1-4 л
+    bool lensingLut = false;        // Ԥ͸ұѭ
+    bool taa = false;               // ʱ俹ݣ + ʷͶӰ AA 
+    bool geodesicCache = false;     // ʱÿصĲֻ߽ɫ
+    int adaptiveBlock = 0;          // ֲӦֱʵĿС2  40 ʾر
+    float adaptiveThreshold = 0.03f; // Ӧϸɫֵ٤У 0-1
+    bool analyticCrossing = false;  //  pos.y 潻㣬ȥƽĲ
+    bool rk45 = false;              // Dormand-Prince 5(4) Ӧ̶ʽ
+    float rkTolerance = 1e-4f;      // Ӧÿ
+    bool weakField = false;         // ľ֤Ĺ߰ƫ۽ǽݣ
+    bool countSteps = false;        // ͳÿ֡ÿߵƽֲÿ֡أȴ GPU
+    bool tileClassify = false;      // Ƭͣ /  / ӽ磩ȥ֧רó
+    bool diskNoiseTexture = false;  // raymarchDisk ļֵΪԤ決ĸ
+    NoiseHash noiseHash = NoiseHash::Sin; // ֵĸϣˣֻӰ GLSLCPU Ⱦ sin ϣ
+    int backgroundCubemap = 0;      // ͼÿ߳0 ʾؼ background()
+    bool profile = false;           // GPU ʱѯ / ޴ģʽ
+    std::string profileCsv;         // ֡д CSV ļձʾֻ stdout
+    float dynamicResolution = 0.0f; // ֱ̬ʵ֡ʱԤ㣨ms0 ʾر
+    float minScale = 0.25f;         // ֱ̬ʵȾΧÿᣩ
+    float maxScale = 1.0f;
+    float scaleHysteresis = 0.1f;   // ʱԤ +-10% ʱ
+    float upscaleSharpness = 0.0f;  // Ŵ pass ǿȣ0 Ϊ˫
+    int stillSamples = 0;           // ֡Ŀÿأ0 ʾۻ
+    float stillSeconds = 0.0f;      // ֡ʱԤ㣨룩ȵԤ㼴ֹͣ0 ʾ
+    int stillPreview = 0;           // ÿۻôдһм0 ʾֻдս
+    int stillTile = 0;              // ֿ֡ȾĿ߳дļ0 ʾһȾ
+    int captureRing = 0;            // ޴ģʽ첽ػ PBO 0 ʾÿ֡ͬ glReadPixels
+    bool capture = false;           // ģʽÿһ֡ PBO زд output
+    std::string exportPath;         // Ƶļ滻е {output}
+    int exportFps = 60;             // ֡ʣ k ֡ iTime = startTime + k / exportFps
+    float exportSeconds = 0.0f;     // ʱ룩0 ʾ frames ֡
+    std::string exportEncoder;      // ģ壬ձʾ DefaultVideoEncoderffmpeg
+    int exportQueue = 8;            // ֮не֡
+    int contexts = 1;               // ޴ / ģʽһڲȾ EGL ģ̣߳
+    std::string serveSocket;        // Ⱦ Unix ׽·
+    int serveMaxBatch = 16;         // Ⱦÿϲ
+    float serveBatchWindow = 0.0f;  // Ⱦȡȴʱ䣨ms0 ʾֻϲŶӵ
+    int loadClients = 8;            // ѹԵĲ
+    int loadRequests = 16;          // ѹÿӵ
+    int views = 0;                  // ͼͼͼ0 ʾöͼ
+    bool viewsCompare = false;      // ͼģʽͬʱͼƣȽϺʱ
+    int farmWorkers = 0;            // ȾũڱĹ
+    std::string farmDir = "farm";   // ȾũҵĿ¼̨ʱڹļϵͳϣ
+    int farmChunk = 8;              // ÿҵ֡
+    int farmRetries = 2;            // ҵŻضе
+    int farmLease = 300;            // ҵԼ룩ȡ߳ôûһ֡Ϊ
+    std::string programCache = "shader_cache"; // ƻĿ¼ձʾÿδԴ
+    int threads = 0;                // CPU Ⱦ߳0 ʾȫӲ߳
+    std::string output = "frame_%04d.ppm"; // ļģ
+};
+
+// вʧʱӡ÷ false
+bool parseRenderConfig(int argc, char** argv, RenderConfig& config);
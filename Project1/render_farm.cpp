@@ -0,0 +1,581 @@
+#include <glad/glad.h>
+#include <iostream>
+#include "render_farm.h"
+
+#ifdef _WIN32
+
+int runRenderFarm(const RenderConfig& config, int argc, char** argv, const char* vertexSource, const char* fragmentSource)
+{
+    std::cout << "Ⱦũ֧ LinuxEGL" << std::endl;
+    return -1;
+}
+
+int runFarmWorker(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    std::cout << "Ⱦũ֧ LinuxEGL" << std::endl;
+    return -1;
+}
+
+#else
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utime.h>
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+#include "image_write.h"
+
+// ҵ嵥̰嵥ʱ iTime --time/--dt һҲӰ
+// Ӱ컭Ĳ settings У̵֮һʱܾȾ
+struct FarmManifest
+{
+    int startFrame = 0;
+    int frames = 0;
+    int chunk = 0;
+    int jobCount = 0;
+    float startTime = 0.0f;
+    float timeStep = 0.0f;
+    int width = 0;
+    int height = 0;
+    std::string settings;   // imageSettings() ı
+};
+
+struct FarmJob
+{
+    int first = 0;
+    int count = 0;
+    int attempts = 0;
+    std::string owner;  // ȡߣֻ .run д
+};
+
+static std::string hostName()
+{
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) != 0)
+        return "localhost";
+    return name;
+}
+
+static std::string workerName(pid_t pid)
+{
+    return hostName() + "-" + std::to_string(pid);
+}
+
+static std::string jobPath(const std::string& dir, int id, const char* state)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "job_%06d.", id);
+    return dir + "/" + name + state;
+}
+
+static bool fileExists(const std::string& path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+// ļ޸ļʱ -1
+static double fileAgeSeconds(const std::string& path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+        return -1.0;
+    return std::difftime(std::time(nullptr), st.st_mtime);
+}
+
+// д˽еʱļٸ̲дһļ
+static bool writeFileAtomic(const std::string& path, const std::string& content)
+{
+    std::string temporary = path + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream file(temporary);
+        file << content;
+        if (!file)
+            return false;
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+static std::string jobContent(const FarmJob& job)
+{
+    return std::to_string(job.first) + " " + std::to_string(job.count) + " " + std::to_string(job.attempts) + "\n";
+}
+
+static bool readJob(const std::string& path, FarmJob& job)
+{
+    std::ifstream file(path);
+    if (!(file >> job.first >> job.count >> job.attempts))
+        return false;
+    file >> job.owner;
+    return true;
+}
+
+// FNV-1a 64 λϣ
+static unsigned long long hashText(unsigned long long hash, const char* text)
+{
+    for (const char* p = text; *p; p++)
+    {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// ֱʡʱ֮Ӱ컭ȫÿ " ֵ"ꡢʡɫ忪أԼɫԴĹϣ
+// ϵ blackhole.frag 汾ͬͬ벻һµ֡TAA ũǹرգг
+static std::string imageSettings(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    std::string settings;
+    auto add = [&](const char* name, double value)
+    {
+        // ܾȷԭ float λд
+        char line[96];
+        std::snprintf(line, sizeof(line), "%s %.9g\n", name, value);
+        settings += line;
+    };
+    add("mouse-x", config.mouseX);
+    add("mouse-y", config.mouseY);
+    add("quality", static_cast<int>(config.quality));
+    add("lensing-lut", config.lensingLut);
+    add("geodesic-cache", config.geodesicCache);
+    add("adaptive", config.adaptiveBlock);
+    add("adaptive-threshold", config.adaptiveThreshold);
+    add("analytic-crossing", config.analyticCrossing);
+    add("rk45", config.rk45);
+    add("rk-tolerance", config.rkTolerance);
+    add("weak-field", config.weakField);
+    add("count-steps", config.countSteps);
+    add("tile-classify", config.tileClassify);
+    add("disk-noise-texture", config.diskNoiseTexture);
+    add("noise-hash", static_cast<int>(config.noiseHash));
+    add("background-cubemap", config.backgroundCubemap);
+    add("still", config.stillSamples);
+    add("still-tile", config.stillTile);
+
+    char line[64];
+    unsigned long long hash = hashText(14695981039346656037ull, vertexSource);
+    std::snprintf(line, sizeof(line), "shader %016llx\n", hashText(hash, fragmentSource));
+    return settings + line;
+}
+
+static bool writeManifest(const std::string& path, const FarmManifest& m)
+{
+    std::string content = std::to_string(m.startFrame) + " " + std::to_string(m.frames) + " " + std::to_string(m.chunk) + " " +
+        std::to_string(m.jobCount) + " " + std::to_string(m.width) + " " + std::to_string(m.height) + "\n";
+    // ʱܾȷԭ float λд
+    char times[64];
+    std::snprintf(times, sizeof(times), "%.9g %.9g\n", m.startTime, m.timeStep);
+    return writeFileAtomic(path, content + times + m.settings);
+}
+
+static bool readManifest(const std::string& path, FarmManifest& m)
+{
+    std::ifstream file(path);
+    if (!(file >> m.startFrame >> m.frames >> m.chunk >> m.jobCount >> m.width >> m.height >> m.startTime >> m.timeStep))
+        return false;
+    // Ϊûв嵥ɰ汾дΪȡʧ
+    std::string line;
+    std::getline(file, line);
+    m.settings.clear();
+    while (std::getline(file, line))
+    {
+        if (!line.empty())
+            m.settings += line + "\n";
+    }
+    return !m.settings.empty();
+}
+
+static bool sameManifest(const FarmManifest& a, const FarmManifest& b)
+{
+    return a.startFrame == b.startFrame && a.frames == b.frames && a.chunk == b.chunk && a.jobCount == b.jobCount &&
+        a.width == b.width && a.height == b.height && a.startTime == b.startTime && a.timeStep == b.timeStep &&
+        a.settings == b.settings;
+}
+
+// гݲвͬ
+static void printSettingsDiff(const std::string& self, const std::string& expected, const std::string& actual)
+{
+    std::istringstream a(expected), b(actual);
+    std::string lineA, lineB;
+    while (true)
+    {
+        bool hasA = static_cast<bool>(std::getline(a, lineA));
+        bool hasB = static_cast<bool>(std::getline(b, lineB));
+        if (!hasA && !hasB)
+            break;
+        if (!hasA || !hasB || lineA != lineB)
+            std::cout << "[" << self << "]   嵥" << (hasA ? lineA : "ޣ") << "̣" << (hasB ? lineB : "ޣ") << std::endl;
+    }
+}
+
+// ҵɻѷ
+static bool jobFinished(const std::string& dir, int id)
+{
+    return fileExists(jobPath(dir, id, "done")) || fileExists(jobPath(dir, id, "failed"));
+}
+
+static int countJobs(const std::string& dir, int jobCount, const char* state)
+{
+    int count = 0;
+    for (int id = 0; id < jobCount; id++)
+        count += fileExists(jobPath(dir, id, state)) ? 1 : 0;
+    return count;
+}
+
+//  .run ҵŻضУԴ + 1 retries θΪ .failed
+// Ȱ .run Լ£ͬʱͬһҵʱֻһɹ
+static void requeueJob(const std::string& dir, int id, int retries, const char* reason)
+{
+    std::string claimed = jobPath(dir, id, "requeue") + "." + std::to_string(getpid());
+    if (std::rename(jobPath(dir, id, "run").c_str(), claimed.c_str()) != 0)
+        return;
+
+    FarmJob job;
+    bool valid = readJob(claimed, job);
+    job.attempts++;
+    bool failed = !valid || job.attempts > retries;
+    std::remove(claimed.c_str());
+    // 
+    if (!valid || !writeFileAtomic(jobPath(dir, id, failed ? "failed" : "todo"), jobContent(job)))
+        failed = true;
+    if (failed)
+        std::cout << "ҵ " << id << " ʧܣ" << reason << " " << retries << " Σ" << std::endl;
+    else
+        std::cout << "ҵ " << id << "֡ " << job.first << " ~ " << job.first + job.count - 1 << "ŻضУ"
+            << reason << " " << job.attempts << " " << std::endl;
+}
+
+enum class JobResult
+{
+    Done,
+    LeaseLost,  // Լʱգҵ̽
+    Error,
+};
+
+static JobResult renderJob(BlackholeRenderer& renderer, const RenderTarget& target, const RenderConfig& config,
+    const FarmManifest& manifest, const FarmJob& job, const std::string& runPath, const std::string& self,
+    std::vector<unsigned char>& pixels)
+{
+    float w = static_cast<float>(manifest.width);
+    float h = static_cast<float>(manifest.height);
+    for (int index = job.first; index < job.first + job.count; index++)
+    {
+        //  --headless  iTime ʽͬͬһ֡κνнһ
+        float time = manifest.startTime + index * manifest.timeStep;
+        bindRenderTarget(target);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawBlackhole(renderer, time, w, h, config.mouseX * w, config.mouseY * h);
+        glReadPixels(0, 0, manifest.width, manifest.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+        std::string path = formatFramePath(config.output, index);
+        std::string temporary = path + "." + self + ".tmp";
+        // 
+        if (!writeImagePPM(temporary, manifest.width, manifest.height, pixels.data(), true) ||
+            std::rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            std::cout << "[" << self << "] д֡ʧܣ" << path << std::endl;
+            std::remove(temporary.c_str());
+            return JobResult::Error;
+        }
+        // ⣻.run Ѿ˵Լʱ
+        if (utime(runPath.c_str(), nullptr) != 0)
+            return JobResult::LeaseLost;
+    }
+    return JobResult::Done;
+}
+
+int runFarmWorker(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    std::string self = workerName(getpid());
+    std::string dir = config.farmDir;
+
+    // ϵĹ̿Эȴ嵥
+    FarmManifest manifest;
+    for (int waited = 0; !readManifest(dir + "/jobs.txt", manifest); waited++)
+    {
+        // 
+        if (waited >= 60)
+        {
+            std::cout << "[" << self << "] ȡҵ嵥ʧܣ" << dir << "/jobs.txt" << std::endl;
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    if (manifest.width != config.width || manifest.height != config.height)
+    {
+        std::cout << "[" << self << "] ֱҵ嵥һ£" << manifest.width << "x" << manifest.height << "" << std::endl;
+        return -1;
+    }
+    // 
+    std::string settings = imageSettings(config, vertexSource, fragmentSource);
+    if (settings != manifest.settings)
+    {
+        std::cout << "[" << self << "] Ӱ컭Ĳҵ嵥һ£ܾȾũʱʹЭͬĲ" << std::endl;
+        printSettingsDiff(self, manifest.settings, settings);
+        return -1;
+    }
+
+    // TAA Ľһ̡֡ͬͬз᲻ͬ
+    RenderConfig workerConfig = config;
+    if (workerConfig.taa)
+    {
+        std::cout << "[" << self << "] ȾũҪÿ֡ --taa" << std::endl;
+        workerConfig.taa = false;
+    }
+
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return -1;
+    BlackholeRenderer renderer;
+    if (!createBlackholeRenderer(renderer, workerConfig, vertexSource, fragmentSource))
+    {
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    RenderTarget target;
+    if (!createRenderTarget(target, manifest.width, manifest.height, GL_RGBA8))
+    {
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    std::vector<unsigned char> pixels(static_cast<size_t>(manifest.width) * manifest.height * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    int result = 0;
+    int renderedFrames = 0;
+    while (result == 0)
+    {
+        bool pending = false;
+        bool claimed = false;
+        for (int id = 0; id < manifest.jobCount && result == 0; id++)
+        {
+            if (jobFinished(dir, id))
+                continue;
+            pending = true;
+
+            std::string runPath = jobPath(dir, id, "run");
+            if (std::rename(jobPath(dir, id, "todo").c_str(), runPath.c_str()) != 0)
+            {
+                // ѱȡԼ˵ȡߣϣѾ
+                if (fileAgeSeconds(runPath) > config.farmLease)
+                    requeueJob(dir, id, config.farmRetries, "Լʱ");
+                continue;
+            }
+
+            claimed = true;
+            FarmJob job;
+            if (!readJob(runPath, job))
+            {
+                requeueJob(dir, id, config.farmRetries, "ҵļ");
+                continue;
+            }
+            std::ofstream(runPath, std::ios::app) << self << "\n";
+
+            auto start = std::chrono::steady_clock::now();
+            JobResult jobResult = renderJob(renderer, target, workerConfig, manifest, job, runPath, self, pixels);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (jobResult == JobResult::Error)
+            {
+                // ҵ .runЭڱ˳Żض
+                result = -1;
+                break;
+            }
+            if (jobResult == JobResult::LeaseLost || std::rename(runPath.c_str(), jobPath(dir, id, "done").c_str()) != 0)
+            {
+                std::cout << "[" << self << "] ҵ " << id << " Լѱգ" << std::endl;
+                continue;
+            }
+            renderedFrames += job.count;
+            std::cout << "[" << self << "] ҵ " << id << "֡ " << job.first << " ~ " << job.first + job.count - 1
+                << " ɣ" << job.count / seconds << " ֡/s" << std::endl;
+        }
+        if (!pending)
+            break;
+        // ʣµҵڱɻԼ
+        if (!claimed && result == 0)
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    if (result == 0)
+        std::cout << "[" << self << "] ѿգȾ " << renderedFrames << " ֡" << std::endl;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    deleteRenderTarget(target);
+    deleteBlackholeRenderer(renderer);
+    destroyOffscreenContext(ctx);
+    return result;
+}
+
+static pid_t spawnWorker(const std::vector<std::string>& args)
+{
+    // ӽ̼̳вظ
+    std::cout.flush();
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        std::vector<char*> argv;
+        for (const std::string& arg : args)
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        argv.push_back(nullptr);
+        execvp(argv[0], argv.data());
+        std::perror("execvp");
+        _exit(127);
+    }
+    // 
+    if (pid < 0)
+        std::cout << "ʧܣ" << std::endl;
+    return pid;
+}
+
+int runRenderFarm(const RenderConfig& config, int argc, char** argv, const char* vertexSource, const char* fragmentSource)
+{
+    std::string dir = config.farmDir;
+    mkdir(dir.c_str(), 0755);
+
+    FarmManifest manifest;
+    manifest.startFrame = config.startFrame;
+    manifest.frames = config.frames;
+    manifest.chunk = config.farmChunk;
+    manifest.jobCount = (config.frames + config.farmChunk - 1) / config.farmChunk;
+    manifest.startTime = config.startTime;
+    manifest.timeStep = config.timeStep;
+    manifest.width = config.width;
+    manifest.height = config.height;
+    manifest.settings = imageSettings(config, vertexSource, fragmentSource);
+
+    std::string manifestPath = dir + "/jobs.txt";
+    auto jobFrames = [&](int id) { return std::min(config.farmChunk, config.startFrame + config.frames - (config.startFrame + id * config.farmChunk)); };
+    FarmManifest existing;
+    if (readManifest(manifestPath, existing))
+    {
+        // 
+        if (!sameManifest(existing, manifest))
+        {
+            std::cout << "Ŀ¼ " << dir << " вͬҵ嵥һ --farm-dir ɾĿ¼" << std::endl;
+            return -1;
+        }
+        std::cout << "жУ" << countJobs(dir, manifest.jobCount, "done") << " / " << manifest.jobCount
+            << " ҵ" << std::endl;
+    }
+    else
+    {
+        // 嵥д룬̿嵥ʱҵļѾ
+        for (int id = 0; id < manifest.jobCount; id++)
+        {
+            FarmJob job;
+            job.first = config.startFrame + id * config.farmChunk;
+            job.count = jobFrames(id);
+            // 
+            if (!writeFileAtomic(jobPath(dir, id, "todo"), jobContent(job)))
+            {
+                std::cout << "дҵļʧܣ" << jobPath(dir, id, "todo") << std::endl;
+                return -1;
+            }
+        }
+        if (!writeManifest(manifestPath, manifest))
+        {
+            std::cout << "дҵ嵥ʧܣ" << manifestPath << std::endl;
+            return -1;
+        }
+    }
+    std::cout << "Ⱦũ֡ " << config.startFrame << " ~ " << config.startFrame + config.frames - 1 << ""
+        << manifest.jobCount << " ҵÿ " << config.farmChunk << " ֡" << config.farmWorkers
+        << " ̣Ŀ¼ " << dir << std::endl;
+
+    // ñ̵ȫȥ --farm <n>Ϊ --farm-worker
+    std::vector<std::string> workerArgs = { argv[0] };
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]) == "--farm" && i + 1 < argc)
+            i++;
+        else
+            workerArgs.push_back(argv[i]);
+    }
+    workerArgs.push_back("--farm-worker");
+
+    // жʱֻͳƱȾ֡
+    std::vector<bool> doneBefore(manifest.jobCount);
+    for (int id = 0; id < manifest.jobCount; id++)
+        doneBefore[id] = jobFinished(dir, id);
+
+    std::vector<pid_t> workers;
+    for (int i = 0; i < config.farmWorkers; i++)
+    {
+        pid_t pid = spawnWorker(workerArgs);
+        if (pid > 0)
+            workers.push_back(pid);
+    }
+
+    // ޷ģʱ޲
+    int respawnLimit = config.farmWorkers * (config.farmRetries + 1);
+    int respawns = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (!workers.empty())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        for (size_t i = 0; i < workers.size();)
+        {
+            int status = 0;
+            pid_t pid = workers[i];
+            if (waitpid(pid, &status, WNOHANG) != pid)
+            {
+                i++;
+                continue;
+            }
+            workers.erase(workers.begin() + i);
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+                continue;
+
+            std::string name = workerName(pid);
+            if (WIFSIGNALED(status))
+                std::cout << " " << name << " ź " << WTERMSIG(status) << " ֹ" << std::endl;
+            else
+                std::cout << " " << name << " 쳣˳" << WEXITSTATUS(status) << "" << std::endl;
+
+            // δɵҵŻضУصԼ
+            bool pending = false;
+            for (int id = 0; id < manifest.jobCount; id++)
+            {
+                FarmJob job;
+                if (readJob(jobPath(dir, id, "run"), job) && job.owner == name)
+                    requeueJob(dir, id, config.farmRetries, "˳");
+                pending = pending || !jobFinished(dir, id);
+            }
+            if (pending && respawns < respawnLimit)
+            {
+                pid_t replacement = spawnWorker(workerArgs);
+                if (replacement > 0)
+                {
+                    workers.push_back(replacement);
+                    respawns++;
+                }
+            }
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    int done = countJobs(dir, manifest.jobCount, "done");
+    int failed = countJobs(dir, manifest.jobCount, "failed");
+    int renderedFrames = 0;
+    for (int id = 0; id < manifest.jobCount; id++)
+        renderedFrames += !doneBefore[id] && fileExists(jobPath(dir, id, "done")) ? jobFrames(id) : 0;
+    std::cout << "Ⱦũ" << done << " / " << manifest.jobCount << " ҵɣ" << failed << " ʧܣ乤 "
+        << respawns << " ΣȾ " << renderedFrames << " ֡ʱ " << seconds << " s" << renderedFrames / seconds
+        << " ֡/s" << std::endl;
+    return done == manifest.jobCount ? 0 : -1;
+}
+
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+#include "render_config.h"
+
+// Ⱦũ֡ [startFrame, startFrame + frames)  farmChunk ֡гҵŽ farmDir µļУ
+// ɶ޴ȾȡֻԭӸ̨ͬһĿ¼ɹͬѣ
+//   jobs.txt              ҵ嵥ʼ֡֡ÿ֡ҵʱʾϴεĶ
+//   job_000012.todo       ȡΪ "ʼ֡ ֡ Դ"
+//   job_000012.run        ѱȡɹ߻ҵĩβ׷ȡ "-pid"Ⱦÿ֡޸ʱΪԼ
+//   job_000012.done       
+//   job_000012.failed      farmRetries ʧ
+// ˳ʱЭ̰ҵŻضвһ̣ϵĹʱ
+// Լ farmLease δµҵɿеĹ̷ŻضС
+// jobs.txt ¼Ӱ컭ȫꡢʡɫ忪ءɫԴϣ
+// ̵Ĳ֮һʱܾȾòͬũҲ벻һµ֡
+// ÿ֡ iTime ֻȫ֡žдʱļٸظȾ֡ͬ䷽ʽ޹
+
+// Э̣--farm <n>Уڱ n ̣ --farm-workerȴȫҵ
+int runRenderFarm(const RenderConfig& config, int argc, char** argv, const char* vertexSource, const char* fragmentSource);
+
+// ̣--farm-worker EGL зȡҵȾûδɵҵʱ˳
+int runFarmWorker(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
@@ -0,0 +1,586 @@
+#include <glad/glad.h>
+#include <iostream>
+#include "render_server.h"
+
+#ifdef _WIN32
+
+int runRenderServer(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    std::cout << "Ⱦ֧ LinuxEGLUnix ׽֣" << std::endl;
+    return -1;
+}
+
+int runLoadTest(const RenderConfig& config)
+{
+    std::cout << "Ⱦ֧ LinuxEGLUnix ׽֣" << std::endl;
+    return -1;
+}
+
+#else
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+#include "image_write.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// ȷλ
+static double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0.0;
+    size_t rank = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+// ͳƱӳ
+const size_t ServerLatencyWindow = 4096;
+
+struct ServerRequest
+{
+    int width = 0;
+    int height = 0;
+    ShaderQuality quality = ShaderQuality::High;
+    float time = 0.0f;
+    float mouseX = 0.0f;
+    float mouseY = 0.0f;
+    Clock::time_point received;
+    std::string response;   // Ⱦ߳д
+    bool done = false;
+};
+
+// ߳Ⱦ֮߳ͳ
+struct ServerState
+{
+    std::mutex mutex;
+    std::condition_variable changed;    // ֹͣȾ߳
+    std::condition_variable finished;   // ɣ߳
+    std::condition_variable closed;     // ӽֹͣ
+    std::deque<ServerRequest*> pending;
+    bool stopping = false;
+
+    int listenFd = -1;
+    std::map<int, std::thread> connections;     // ڷӣʱ߳ԼƳ
+
+    long long served = 0;
+    long long batches = 0;
+    long long rejected = 0;
+    int maxBatchSeen = 0;
+    std::vector<double> latencies;      // ӳ٣յȾɣα
+    size_t latencyPos = 0;
+};
+
+// Ⱦ̳߳е GL ԴÿֱַһĿ꣬ʹ̭
+struct ServerRenderer
+{
+    BlackholeRenderer renderer;
+    std::map<std::pair<int, int>, RenderTarget> targets;
+    std::map<std::pair<int, int>, long long> lastUsed;
+    unsigned int pbo = 0;
+    long long batchCounter = 0;
+};
+
+const size_t MaxServerTargets = 4;
+
+static bool sendAll(int fd, const char* data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0)
+            return false;
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+static bool sendAll(int fd, const std::string& data)
+{
+    return sendAll(fd, data.data(), data.size());
+}
+
+//  buffer ȡһУУʱӹرջг MaxServerLineLength ʱ false
+// ߵ buffer Уbuffer.size() > MaxServerLineLength÷ݴ
+static bool readLine(int fd, std::string& buffer, std::string& line)
+{
+    for (;;)
+    {
+        size_t end = buffer.find('\n');
+        if (std::min(end, buffer.size()) > MaxServerLineLength)
+            return false;
+        if (end != std::string::npos)
+        {
+            line = buffer.substr(0, end);
+            buffer.erase(0, end + 1);
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            return true;
+        }
+        char chunk[4096];
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0)
+            return false;
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+}
+
+static bool readExactly(int fd, std::string& buffer, size_t size, std::string& data)
+{
+    while (buffer.size() < size)
+    {
+        char chunk[65536];
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0)
+            return false;
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+    data = buffer.substr(0, size);
+    buffer.erase(0, size);
+    return true;
+}
+
+//  render Ĳʧʱشԭ
+static std::string parseRenderRequest(std::istringstream& args, ServerRequest& request)
+{
+    std::string quality;
+    if (!(args >> request.width >> request.height >> quality >> request.time >> request.mouseX >> request.mouseY))
+        return "÷render <> <> <> <iTime> < x> < y>";
+    if (request.width <= 0 || request.height <= 0 || request.width > MaxServerResolution || request.height > MaxServerResolution)
+        return "ֱʱ 1 ~ " + std::to_string(MaxServerResolution) + " ֮";
+    if (!parseShaderQuality(quality, request.quality))
+        return "δ֪ʣ" + quality;
+    return std::string();
+}
+
+static std::string serverStats(ServerState& state)
+{
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::ostringstream stats;
+    stats << "served " << state.served << " batches " << state.batches << " avg_batch "
+        << (state.batches > 0 ? static_cast<double>(state.served) / state.batches : 0.0) << " max_batch " << state.maxBatchSeen
+        << " rejected " << state.rejected << " p50_ms " << percentile(state.latencies, 0.50) << " p99_ms "
+        << percentile(state.latencies, 0.99);
+    return stats.str();
+}
+
+static void serveConnection(int fd, ServerState& state)
+{
+    std::string buffer;
+    std::string line;
+    while (readLine(fd, buffer, line))
+    {
+        std::istringstream args(line);
+        std::string command;
+        args >> command;
+        std::string reply;
+        if (command == "render")
+        {
+            ServerRequest request;
+            std::string error = parseRenderRequest(args, request);
+            if (error.empty())
+            {
+                request.received = Clock::now();
+                std::unique_lock<std::mutex> lock(state.mutex);
+                if (state.stopping)
+                    error = "ֹͣ";
+                else
+                {
+                    state.pending.push_back(&request);
+                    state.changed.notify_all();
+                    state.finished.wait(lock, [&]() { return request.done; });
+                }
+            }
+            if (!error.empty())
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.rejected++;
+            }
+            reply = error.empty() ? std::move(request.response) : "error " + error + "\n";
+        }
+        else if (command == "stats")
+            reply = "ok " + serverStats(state) + "\n";
+        else if (command == "shutdown")
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.stopping = true;
+            state.changed.notify_all();
+            reply = "ok\n";
+        }
+        else
+            reply = "error δ֪" + command + "\n";
+        if (!sendAll(fd, reply))
+            break;
+    }
+    if (buffer.size() > MaxServerLineLength)
+        sendAll(fd, "error  " + std::to_string(MaxServerLineLength) + " ֽڣ\n");
+
+    // ӽر׽ֲƳԼ̷߳˳
+    // ߳ڼ״̬´̲߳ǼǣһҵԼ
+    std::lock_guard<std::mutex> lock(state.mutex);
+    close(fd);
+    auto self = state.connections.find(fd);
+    self->second.detach();
+    state.connections.erase(self);
+    state.closed.notify_all();
+}
+
+static void acceptConnections(ServerState& state)
+{
+    for (;;)
+    {
+        int fd = accept(state.listenFd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            int error = errno;
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (state.stopping)
+                    break;  // ֹͣʱ׽ֱر
+            }
+            if (error == EINTR || error == ECONNABORTED)
+                continue;
+            // ļڴʱ꣺ӽٽ
+            if (error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM)
+            {
+                std::cout << "ʧܣ" << std::strerror(error) << "Ժԣ" << std::endl;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+            // 
+            std::cout << "ʧܣ" << std::strerror(error) << "" << std::endl;
+            break;
+        }
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.stopping)
+        {
+            close(fd);
+            break;
+        }
+        state.connections.emplace(fd, std::thread(serveConnection, fd, std::ref(state)));
+    }
+}
+
+static RenderTarget* serverTarget(ServerRenderer& server, int width, int height)
+{
+    std::pair<int, int> size(width, height);
+    server.lastUsed[size] = server.batchCounter;
+    auto found = server.targets.find(size);
+    if (found != server.targets.end())
+        return &found->second;
+
+    // ֱ̫ʱ̭δõĿ
+    if (server.targets.size() >= MaxServerTargets)
+    {
+        auto oldest = server.targets.begin();
+        for (auto it = server.targets.begin(); it != server.targets.end(); ++it)
+        {
+            if (server.lastUsed[it->first] < server.lastUsed[oldest->first])
+                oldest = it;
+        }
+        deleteRenderTarget(oldest->second);
+        server.lastUsed.erase(oldest->first);
+        server.targets.erase(oldest);
+    }
+    RenderTarget target;
+    if (!createRenderTarget(target, width, height, GL_RGBA8))
+        return nullptr;
+    return &server.targets.emplace(size, target).first->second;
+}
+
+// һֱ뻭ͬƲصͬһ PBO Ĳͬλãֻȴһդ
+static void renderBatch(ServerRenderer& server, const std::vector<ServerRequest*>& batch)
+{
+    server.batchCounter++;
+    int width = batch[0]->width;
+    int height = batch[0]->height;
+    RenderTarget* target = serverTarget(server, width, height);
+    if (target == nullptr || !setBlackholeQuality(server.renderer, batch[0]->quality))
+    {
+        for (ServerRequest* request : batch)
+            request->response = "error ȾԴʧ\n";
+        return;
+    }
+
+    size_t frameSize = static_cast<size_t>(width) * height * 3;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, server.pbo);
+    glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(frameSize * batch.size()), nullptr, GL_STREAM_READ);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    float w = static_cast<float>(width);
+    float h = static_cast<float>(height);
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        const ServerRequest& request = *batch[i];
+        bindRenderTarget(*target);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawBlackhole(server.renderer, request.time, w, h, request.mouseX * w, request.mouseY * h);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, server.pbo);
+        glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, reinterpret_cast<void*>(frameSize * i));
+    }
+
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED)
+        ;
+    glDeleteSync(fence);
+
+    const unsigned char* pixels = static_cast<const unsigned char*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+        static_cast<GLsizeiptr>(frameSize * batch.size()), GL_MAP_READ_BIT));
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        if (pixels == nullptr)
+        {
+            batch[i]->response = "error ʧ\n";
+            continue;
+        }
+        std::string image = encodeImagePPM(width, height, pixels + frameSize * i, true);
+        batch[i]->response = "ok " + std::to_string(image.size()) + "\n" + image;
+    }
+    if (pixels != nullptr)
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+static bool compatibleRequests(const ServerRequest& a, const ServerRequest& b)
+{
+    return a.width == b.width && a.height == b.height && a.quality == b.quality;
+}
+
+// Ⱦ̣߳ȡڵȸٴмݵŶ maxBatch 
+static void renderLoop(ServerRenderer& server, ServerState& state, const RenderConfig& config)
+{
+    auto window = std::chrono::microseconds(static_cast<long long>(config.serveBatchWindow * 1000.0f));
+    size_t maxBatch = static_cast<size_t>(config.serveMaxBatch);
+    for (;;)
+    {
+        std::vector<ServerRequest*> batch;
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.changed.wait(lock, [&]() { return !state.pending.empty() || state.stopping; });
+            if (state.pending.empty())
+                break;
+            if (state.pending.size() < maxBatch && window.count() > 0)
+                state.changed.wait_for(lock, window, [&]() { return state.pending.size() >= maxBatch || state.stopping; });
+
+            const ServerRequest head = *state.pending.front();
+            for (auto it = state.pending.begin(); it != state.pending.end() && batch.size() < maxBatch;)
+            {
+                if (compatibleRequests(head, **it))
+                {
+                    batch.push_back(*it);
+                    it = state.pending.erase(it);
+                }
+                else
+                    ++it;
+            }
+        }
+
+        renderBatch(server, batch);
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (ServerRequest* request : batch)
+        {
+            double latency = elapsedMs(request->received);
+            if (state.latencies.size() < ServerLatencyWindow)
+                state.latencies.push_back(latency);
+            else
+                state.latencies[state.latencyPos] = latency;
+            state.latencyPos = (state.latencyPos + 1) % ServerLatencyWindow;
+            request->done = true;
+        }
+        state.served += static_cast<long long>(batch.size());
+        state.batches++;
+        state.maxBatchSeen = std::max(state.maxBatchSeen, static_cast<int>(batch.size()));
+        state.finished.notify_all();
+    }
+}
+
+int runRenderServer(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    // ֮以һ֡״̬ȫʱԤȱ
+    RenderConfig serverConfig = config;
+    serverConfig.allQualities = true;
+    serverConfig.stillSamples = 0;
+    serverConfig.stillTile = 0;
+    if (serverConfig.taa)
+    {
+        std::cout << "Ⱦ --taa" << std::endl;
+        serverConfig.taa = false;
+    }
+
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return -1;
+    ServerRenderer server;
+    if (!createBlackholeRenderer(server.renderer, serverConfig, vertexSource, fragmentSource))
+    {
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    glGenBuffers(1, &server.pbo);
+
+    ServerState state;
+    state.listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    // 
+    if (state.listenFd < 0 || config.serveSocket.size() >= sizeof(address.sun_path))
+    {
+        std::cout << "׽ʧܣ· " << sizeof(address.sun_path) - 1 << " ֽڣ" << std::endl;
+        if (state.listenFd >= 0)
+            close(state.listenFd);
+        glDeleteBuffers(1, &server.pbo);
+        deleteBlackholeRenderer(server.renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    std::strcpy(address.sun_path, config.serveSocket.c_str());
+    unlink(address.sun_path);
+    if (bind(state.listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(state.listenFd, 64) != 0)
+    {
+        std::cout << "׽ʧܣ" << config.serveSocket << "" << std::endl;
+        close(state.listenFd);
+        glDeleteBuffers(1, &server.pbo);
+        deleteBlackholeRenderer(server.renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    std::cout << "GL_RENDERER" << glGetString(GL_RENDERER) << "\nȾ" << config.serveSocket
+        << "ÿ " << config.serveMaxBatch << "  " << config.serveBatchWindow << " ms" << std::endl;
+
+    std::thread acceptor(acceptConnections, std::ref(state));
+    renderLoop(server, state, config);
+
+    // ֹͣرռ׽֣Ͽʣӣȴ̹߳ر׽ֲƳԼ
+    shutdown(state.listenFd, SHUT_RDWR);
+    close(state.listenFd);
+    acceptor.join();
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        for (auto& connection : state.connections)
+            shutdown(connection.first, SHUT_RDWR);
+        state.closed.wait(lock, [&]() { return state.connections.empty(); });
+    }
+    unlink(config.serveSocket.c_str());
+    std::cout << "Ⱦֹͣ" << serverStats(state) << std::endl;
+
+    for (auto& target : server.targets)
+        deleteRenderTarget(target.second);
+    glDeleteBuffers(1, &server.pbo);
+    deleteBlackholeRenderer(server.renderer);
+    destroyOffscreenContext(ctx);
+    return 0;
+}
+
+static int connectServer(const std::string& path)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+int runLoadTest(const RenderConfig& config)
+{
+    std::string quality = shaderQualityPreset(config.quality).name;
+    std::cout << "ѹԣ" << config.loadClients << "  x " << config.loadRequests << " " << config.width << "x"
+        << config.height << " " << quality << std::endl;
+
+    std::vector<std::vector<double>> latencies(config.loadClients);
+    std::vector<int> failures(config.loadClients, 0);
+    std::vector<std::thread> clients;
+    auto start = Clock::now();
+    for (int c = 0; c < config.loadClients; c++)
+    {
+        clients.emplace_back([&, c]()
+        {
+            int fd = connectServer(config.serveSocket);
+            if (fd < 0)
+            {
+                failures[c] = config.loadRequests;
+                return;
+            }
+            std::string buffer;
+            for (int r = 0; r < config.loadRequests; r++)
+            {
+                float time = config.startTime + (c * config.loadRequests + r) * config.timeStep;
+                std::ostringstream request;
+                request << "render " << config.width << " " << config.height << " " << quality << " " << time << " "
+                    << config.mouseX << " " << config.mouseY << "\n";
+                auto sent = Clock::now();
+                std::string line;
+                std::string image;
+                if (!sendAll(fd, request.str()) || !readLine(fd, buffer, line))
+                {
+                    failures[c] += config.loadRequests - r;
+                    break;
+                }
+                size_t size = 0;
+                if (line.compare(0, 3, "ok ") != 0 || (size = std::stoul(line.substr(3))) == 0 ||
+                    !readExactly(fd, buffer, size, image) || image.compare(0, 2, "P6") != 0)
+                {
+                    if (failures[c]++ == 0)
+                        std::cout << "ʧܣ" << line << std::endl;
+                    continue;
+                }
+                latencies[c].push_back(elapsedMs(sent));
+            }
+            close(fd);
+        });
+    }
+    for (std::thread& client : clients)
+        client.join();
+    double seconds = elapsedMs(start) / 1000.0;
+
+    std::vector<double> all;
+    int failed = 0;
+    for (int c = 0; c < config.loadClients; c++)
+    {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        failed += failures[c];
+    }
+    std::cout << all.size() << " ɹ" << failed << " ʧܣʱ " << seconds << " s" << all.size() / seconds
+        << " /s\nӳ p50 " << percentile(all, 0.50) << " / p95 " << percentile(all, 0.95) << " / p99 "
+        << percentile(all, 0.99) << " /  " << percentile(all, 1.0) << " ms" << std::endl;
+
+    int fd = connectServer(config.serveSocket);
+    std::string buffer;
+    std::string line;
+    if (fd >= 0 && sendAll(fd, std::string("stats\n")) && readLine(fd, buffer, line))
+        std::cout << "ˣ" << line << std::endl;
+    if (fd >= 0)
+        close(fd);
+    return failed == 0 ? 0 : -1;
+}
+
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+#include "render_config.h"
+
+// ߳أ
+const int MaxServerResolution = 4096;
+// ֽУʱظ󲢶Ͽ
+const size_t MaxServerLineLength = 4096;
+
+// Ⱦ--serve <socket>פ̣ Unix ׽Ͻ󲢻ظͼPPM
+// ȫʱԤ決Դʱ֮һֱáȾ̰߳Ŷзֱ뻭ͬϳһ
+// Ʋصͬһ PBOֻͬһΡЭΪÿһı
+//   render <> <> <> <iTime> < x> < y>    Ϊһ
+//       -> "ok <ֽ>\n"  PPMP6 "error <ԭ>\n"
+//   stats     -> "ok <ͳ>\n"
+//   shutdown  -> "ok\n"Ŷӵ˳
+// ͬһϵ˳ظԶ
+int runRenderServer(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
+
+// ѹԿͻˣ--load-test <socket>loadClients Ӳ loadRequests  render 
+// ֱʡʡȡ configiTime ŵ/s ӳ p50/p95/p99
+int runLoadTest(const RenderConfig& config);
@@ -0,0 +1,71 @@
+#include <glad/glad.h>
+#include <iostream>
+#include "render_target.h"
+
+bool createRenderTarget(RenderTarget& target, int width, int height, unsigned int internalFormat)
+{
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (width > maxSize || height > maxSize)
+    {
+        std::cout << "ȾĿߴ糬 GL_MAX_TEXTURE_SIZE" << maxSize << "" << width << "x" << height << std::endl;
+        return false;
+    }
+
+    target.width = width;
+    target.height = height;
+
+    glGenTextures(1, &target.colorTex);
+    glBindTexture(GL_TEXTURE_2D, target.colorTex);
+    bool isFloat = internalFormat != GL_RGBA8 && internalFormat != GL_RGB8;
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL_RGBA, isFloat ? GL_FLOAT : GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.colorTex, 0);
+
+    // 
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "֡岻" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        deleteRenderTarget(target);
+        return false;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return true;
+}
+
+void deleteRenderTarget(RenderTarget& target)
+{
+    glDeleteFramebuffers(1, &target.fbo);
+    glDeleteTextures(1, &target.colorTex);
+    glDeleteRenderbuffers(1, &target.depthStencil);
+    target = RenderTarget();
+}
+
+bool attachDepthStencil(RenderTarget& target)
+{
+    glGenRenderbuffers(1, &target.depthStencil);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.depthStencil);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, target.width, target.height);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depthStencil);
+
+    // 
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!complete)
+        std::cout << "/ģ建帽Ӻ֡岻" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return complete;
+}
+
+void bindRenderTarget(const RenderTarget& target)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glViewport(0, 0, target.width, target.height);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+// ȾĿ꣨FBO + ɫѡ/ģ建壩
+struct RenderTarget
+{
+    unsigned int fbo = 0;
+    unsigned int colorTex = 0;
+    unsigned int depthStencil = 0;  // GL_DEPTH24_STENCIL8 Ⱦ壬0 ʾû
+    int width = 0;
+    int height = 0;
+};
+
+// internalFormat  GL_RGBA8 / GL_RGBA16F / GL_RGBA32Fʧʱ false
+bool createRenderTarget(RenderTarget& target, int width, int height, unsigned int internalFormat);
+void deleteRenderTarget(RenderTarget& target);
+// ѴĿ긽ͬߴ/ģ建壨ģԷص pass ʹã
+bool attachDepthStencil(RenderTarget& target);
+//  FBO ӿ
+void bindRenderTarget(const RenderTarget& target);
@@ -3,9 +3,26 @@
 #include <iostream>
 #include <cmath>
 #include "shader_read.h"
+#include "render_config.h"
+#include "headless.h"
+#include "cpu_backend.h"
+#include "blackhole_renderer.h"
+#include "gpu_bench.h"
+#include "noise_bench.h"
+#include "still_render.h"
+#include "video_export.h"
+#include "render_farm.h"
+#include "render_server.h"
+#include "view_atlas.h"
+#include "gpu_profiler.h"
+#include "dynamic_resolution.h"
+#include "program_cache.h"
+#include "frame_capture.h"
+#include "image_write.h"
 
 float iTime = 0.0f;          // ʱ
 float iMouseX = 0.0f, iMouseY = 0.0f; // λãһ
+int screenWidth = 800, screenHeight = 600; // ֡ߴ磨洰Ÿ£
 
 // ȡɫļ
 std::string vertexShaderCode = readShaderFile("blackhole.vert");
@@ -15,24 +32,11 @@ std::string fragmentShaderCode = readShaderFile("blackhole.frag");
 const char* vertexShaderSource = vertexShaderCode.c_str();
 const char* fragmentShaderSource = fragmentShaderCode.c_str();
 
-// iChannel0ɫδ
-unsigned int createDummyTexture()
-{
-    unsigned int tex;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    // 1x1İɫ
-    unsigned char data[] = { 255, 255, 255, 255 };
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    // 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    return tex;
-}
-
 void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
     glViewport(0, 0, width, height);
+    screenWidth = width;
+    screenHeight = height;
 }
 
 void processInput(GLFWwindow* window)
@@ -43,20 +47,63 @@ void processInput(GLFWwindow* window)
 
 void mouse_callback(GLFWwindow* window, double xpos, double ypos)
 {
-    iMouseX = static_cast<float>(xpos) / 800;
-    iMouseY = static_cast<float>(ypos) / 600;
+    int windowWidth, windowHeight;
+    glfwGetWindowSize(window, &windowWidth, &windowHeight);
+    iMouseX = static_cast<float>(xpos) / windowWidth;
+    iMouseY = static_cast<float>(ypos) / windowHeight;
 }
 
 
-int main()
+int main(int argc, char** argv)
 {
+    RenderConfig config;
+    if (!parseRenderConfig(argc, argv, config))
+        return -1;
+    setProgramCacheDirectory(config.programCache);
+
+    switch (config.mode)
+    {
+    case RenderMode::Headless:  // ޴ȾȾũڵ㣩
+        return runHeadless(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::Cpu:       //  CPU Ⱦ
+        return runCpuRender(config);
+    case RenderMode::CpuBench:
+        return runCpuBenchmark(config);
+    case RenderMode::CpuCompare:
+        return runCpuCompare(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::Bench:     // ɫ GPU ʱԱ
+        return runGpuBenchmark(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::NoiseBench:    // ϣ˶Ա
+        return runNoiseBenchmark(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::CaptureBench:  // ֡ؿԱ
+        return runCaptureBenchmark(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::ContextBench:  // ĲȾ
+        return runContextBenchmark(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::Still:     // ۻĸ֡
+        return runStillRender(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::Export:    // ̶Ƶ
+        return runVideoExport(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::Farm:      // ȾũЭ
+        return runRenderFarm(config, argc, argv, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::FarmWorker:    // Ⱦũ
+        return runFarmWorker(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::Serve:     // פȾ
+        return runRenderServer(config, vertexShaderSource, fragmentShaderSource);
+    case RenderMode::LoadTest:  // Ⱦѹ
+        return runLoadTest(config);
+    case RenderMode::MultiView: // ͼͼ
+        return runViewAtlas(config, vertexShaderSource, fragmentShaderSource);
+    default:
+        break;
+    }
+
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
     // create GLFW window
-    GLFWwindow* window = glfwCreateWindow(800, 600, "renderer", NULL, NULL);
+    GLFWwindow* window = glfwCreateWindow(config.width, config.height, "renderer", NULL, NULL);
     if (window == NULL)
     {
         std::cout << "ʧܣ" << std::endl;
@@ -66,6 +113,7 @@ int main()
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetCursorPosCallback(window, mouse_callback);
+    glfwGetFramebufferSize(window, &screenWidth, &screenHeight);
 
     //  GLAD
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -73,138 +121,166 @@ int main()
         std::cout << "ʧܣ" << std::endl;
         return -1;
     }
+    loadProgramCacheFunctions((GLADloadproc)glfwGetProcAddress);
 
-    // ɫ
-	// ɫ
-    unsigned int vertexShader;
-    vertexShader = glCreateShader(GL_VERTEX_SHADER);
-
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-    // 
-	int success;
-	char infoLog[512];
-	glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-		std::cout << "ɫʧܣ" << std::endl;
-		std::cout << infoLog << std::endl;
-	}
-
-	// ɫ
-	unsigned int fragmentShader;
-	fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-	glCompileShader(fragmentShader);
-	// 
-	glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-		std::cout << "ɫʧܣ" << std::endl;
-		std::cout << infoLog << std::endl;
-	}
-
-	// ɫ
-	unsigned int shaderProgram;
-	shaderProgram = glCreateProgram();
-	glAttachShader(shaderProgram, vertexShader);
-	glAttachShader(shaderProgram, fragmentShader);
-	glLinkProgram(shaderProgram);
-	// 
-	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-	if (!success)
-	{
-		glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-		std::cout << "ɫʧܣ" << std::endl;
-		std::cout << infoLog << std::endl;
-	}
-
-	// ʹɫ
-	glUseProgram(shaderProgram);
-
-	// ɾɫ
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
-
-    // 
-    float quadVertices[] = {
-        // λ          // 
-        -1.0f,  1.0f,    0.0f, 1.0f, // 
-        -1.0f, -1.0f,    0.0f, 0.0f, // 
-        1.0f, -1.0f,    1.0f, 0.0f, // 
-        1.0f,  1.0f,    1.0f, 1.0f  // 
+    // ɫ롢㼰Դģʽ 1-4 лʣȫԤȱ룩
+    config.allQualities = true;
+    BlackholeRenderer renderer;
+    if (!createBlackholeRenderer(renderer, config, vertexShaderSource, fragmentShaderSource))
+    {
+        glfwTerminate();
+        return -1;
+    }
+
+    // GPU ֡--profileֱ̬Ҳṩ GPU ʱ
+    bool dynamicResolution = config.dynamicResolution > 0.0f;
+    bool profiling = config.profile || dynamicResolution;
+    GpuProfiler profiler;
+    if (profiling && !createGpuProfiler(profiler, config.profileCsv, config.profile ? 60 : 0))
+    {
+        deleteBlackholeRenderer(renderer);
+        glfwTerminate();
+        return -1;
+    }
+
+    // ֱ̬ʣ--dynamic-resolution
+    DynamicResolution dr;
+    if (dynamicResolution && !createDynamicResolution(dr, config, screenWidth, screenHeight, vertexShaderSource))
+    {
+        deleteGpuProfiler(profiler);
+        deleteBlackholeRenderer(renderer);
+        glfwTerminate();
+        return -1;
+    }
+    long long lastResolved = 0;
+
+    // ֡첽أ--captureػڵһ֡ʹڳߴ仯ʱ֡ߴ紴
+    FrameCapture capture;
+    long long capturedFrames = 0;
+    int captureRing = config.captureRing > 0 ? config.captureRing : 3;
+    FrameConsumer writeFrame = [&](long long frame, const unsigned char* rgb, int width, int height)
+    {
+        writeImagePPM(formatFramePath(config.output, static_cast<int>(frame)), width, height, rgb, true);
     };
-    unsigned int indices[] = { 0, 1, 2, 0, 2, 3 };
-	unsigned int VAO, VBO, EBO;
-
-    glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-    // 0. 
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
-
-    // 壨ıΣ
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    // λԣlayout 0
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // ԣlayout 1
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // 3.  dummy ޸ iChannel0 δ⣩
-    unsigned int dummyTex = createDummyTexture();
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, dummyTex);
-
-    // 3. ȡUniformλãڴݣ
-    GLint iTimeLoc = glGetUniformLocation(shaderProgram, "iTime");
-    GLint iResolutionLoc = glGetUniformLocation(shaderProgram, "iResolution");
-    GLint iMouseLoc = glGetUniformLocation(shaderProgram, "iMouse");
-    GLint iChannel0Loc = glGetUniformLocation(shaderProgram, "iChannel0");
 
     // Ⱦѭ
     while (!glfwWindowShouldClose(window))
     {
+        // Сʱ֡Ϊ 0x0ȴ¼
+        if (screenWidth == 0 || screenHeight == 0)
+        {
+            glfwWaitEvents();
+            continue;
+        }
+
+        if (profiling)
+            beginProfilerFrame(profiler);
+
         // 
         processInput(window);
+        for (int i = 0; i < ShaderQualityCount; i++)
+        {
+            ShaderQuality quality = static_cast<ShaderQuality>(i);
+            if (glfwGetKey(window, GLFW_KEY_1 + i) == GLFW_PRESS && renderer.quality != quality &&
+                setBlackholeQuality(renderer, quality))
+                std::cout << "ʣ" << shaderQualityPreset(quality).name << std::endl;
+        }
 
         iTime += glfwGetTime();
         glfwSetTime(0.0); //  GLFW ʱ䣬
 
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        // ʹɫ
-        glUseProgram(shaderProgram);
-
-        //  Uniform 
-        glUniform1f(iTimeLoc, iTime);
-        glUniform2f(iResolutionLoc, 800, 600);
-        glUniform2f(iMouseLoc, iMouseX * 800, iMouseY * 600);
-        glUniform1i(iChannel0Loc, 0); // Ԫ 0  iChannel0
-
-        // ȫı
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        if (dynamicResolution)
+        {
+            // ص GPU ʱʱ· FBO
+            if (profiler.resolved != lastResolved)
+            {
+                lastResolved = profiler.resolved;
+                updateDynamicResolution(dr, profiler.latest.gpuMs);
+            }
+            if ((dr.outputWidth != screenWidth || dr.outputHeight != screenHeight) &&
+                !resizeDynamicResolution(dr, screenWidth, screenHeight))
+                break;
+
+            float w = static_cast<float>(dynamicRenderWidth(dr));
+            float h = static_cast<float>(dynamicRenderHeight(dr));
+            bindDynamicResolution(dr);
+            beginProfilerPass(profiler, "blackhole");
+            drawBlackhole(renderer, iTime, w, h, iMouseX * w, iMouseY * h);
+            endProfilerPass(profiler);
+
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glViewport(0, 0, screenWidth, screenHeight);
+            beginProfilerPass(profiler, "upscale");
+            drawDynamicUpscale(dr, renderer.quad);
+            endProfilerPass(profiler);
+        }
+        else
+        {
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            // ʹɫ򡢴 Uniform ȫı
+            float w = static_cast<float>(screenWidth);
+            float h = static_cast<float>(screenHeight);
+            if (profiling)
+                beginProfilerPass(profiler, "blackhole");
+            drawBlackhole(renderer, iTime, w, h, iMouseX * w, iMouseY * h);
+            if (profiling)
+                endProfilerPass(profiler);
+        }
+
+        // ֮ǰӺ󻺳أߴ仯ʱȽɳߴ֡ؽػ
+        if (config.capture)
+        {
+            if (capture.width != screenWidth || capture.height != screenHeight)
+            {
+                if (capture.width != 0)
+                {
+                    flushFrameCapture(capture);
+                    deleteFrameCapture(capture);
+                }
+                if (!createFrameCapture(capture, screenWidth, screenHeight, captureRing, writeFrame))
+                    break;
+            }
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            captureFrame(capture, capturedFrames++);
+        }
 
         // 鲢¼
         glfwPollEvents();
         glfwSwapBuffers(window);
+
+        if (profiling)
+            endProfilerFrame(profiler);
+    }
+
+    if (capture.width != 0)
+    {
+        flushFrameCapture(capture);
+        std::cout << "֡أд " << capturedFrames << " ֡ȴ GPU " << capture.stalls << " Σ"
+            << capture.waitMs << " ms" << std::endl;
+        deleteFrameCapture(capture);
+    }
+    if (renderer.adaptive && renderer.refine.measuredFrames > 0)
+        std::cout << "Ӧϸƽ׷ " << 100.0 * renderer.refine.tracedSum / renderer.refine.measuredFrames
+            << "% أ" << renderer.refine.measuredFrames << " ֡" << std::endl;
+    if (renderer.countSteps && renderer.steps.countedFrames > 0)
+        std::cout << "ֲƽ " << renderer.steps.stepsSum / renderer.steps.countedFrames
+            << " /ߣ" << renderer.steps.countedFrames << " ֡" << std::endl;
+    if (dynamicResolution)
+    {
+        std::cout << "ֱ̬ʣʱȾ " << dr.scale << "" << dynamicRenderWidth(dr) << "x"
+            << dynamicRenderHeight(dr) << "" << std::endl;
+        deleteDynamicResolution(dr);
+    }
+    if (profiling)
+    {
+        if (config.profile)
+            finishGpuProfiler(profiler);
+        deleteGpuProfiler(profiler);
     }
 
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
-    glDeleteProgram(shaderProgram);
-    glDeleteTextures(1, &dummyTex);
+    deleteBlackholeRenderer(renderer);
 
     glfwTerminate();
 
@@ -0,0 +1,63 @@
+#include <glad/glad.h>
+#include <iostream>
+#include "shader_program.h"
+
+// 뵥ɫʧʱӡ־ 0
+static unsigned int compileShader(GLenum type, const char* source, const char* name)
+{
+    unsigned int shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    // 
+    int success;
+    char infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cout << name << "ʧܣ" << std::endl;
+        std::cout << infoLog << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+unsigned int createShaderProgram(const char* vertexSource, const char* fragmentSource, bool retrievable)
+{
+    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource, "ɫ");
+    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource, "ɫ");
+    if (vertexShader == 0 || fragmentShader == 0)
+    {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return 0;
+    }
+
+    // ɫ
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    // glProgramParameteri δأĵ GL 4.1  GL_ARB_get_program_binaryʱ򻺴治ȡ
+    if (retrievable && glProgramParameteri)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
+
+    // ɾɫ
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    // 
+    int success;
+    char infoLog[512];
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cout << "ɫʧܣ" << std::endl;
+        std::cout << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// 붥+ƬɫΪʧʱӡ־ 0
+// retrievable Ϊ true ʱǰ GL_PROGRAM_BINARY_RETRIEVABLE_HINTƻʹã
+unsigned int createShaderProgram(const char* vertexSource, const char* fragmentSource, bool retrievable = false);
@@ -0,0 +1,38 @@
+#include <string>
+#include "shader_quality.h"
+
+// ߶Զ밴Լ 1.5 ͵ 48 ݵ _Size * 1000
+static const ShaderQualityPreset Presets[ShaderQualityCount] = {
+    { "low",    1,  6.0f, 12, 4 },
+    { "medium", 1,  8.0f, 16, 5 },
+    { "high",   1, 12.0f, 20, 6 },
+    { "ultra",  2, 16.0f, 24, 8 },
+};
+
+const ShaderQualityPreset& shaderQualityPreset(ShaderQuality quality)
+{
+    return Presets[static_cast<int>(quality)];
+}
+
+std::string shaderQualityDefines(ShaderQuality quality)
+{
+    const ShaderQualityPreset& preset = shaderQualityPreset(quality);
+    // _Steps ɫа float ʹãС
+    return "#define AA " + std::to_string(preset.aa) + "\n"
+        + "#define _Steps " + std::to_string(static_cast<int>(preset.steps)) + ".0\n"
+        + "#define DISK_ITERATIONS " + std::to_string(preset.diskIterations) + "\n"
+        + "#define BEND_STEPS " + std::to_string(preset.bendSteps) + "\n";
+}
+
+bool parseShaderQuality(const std::string& name, ShaderQuality& quality)
+{
+    for (int i = 0; i < ShaderQualityCount; i++)
+    {
+        if (name == Presets[i].name)
+        {
+            quality = static_cast<ShaderQuality>(i);
+            return true;
+        }
+    }
+    return false;
+}
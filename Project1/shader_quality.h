@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+
+// ʵλÿ blackhole.frag һػ壨ע AA/_Steps/ѭ꣩
+enum class ShaderQuality
+{
+    Low,
+    Medium,
+    High,       //  blackhole.frag еĬֵͬ
+    Ultra,
+};
+const int ShaderQualityCount = 4;
+
+struct ShaderQualityPreset
+{
+    const char* name;
+    int aa;                 // AAÿ aa*aa ߣ
+    float steps;            // _Steps
+    int diskIterations;     // DISK_ITERATIONSѭ
+    int bendSteps;          // BEND_STEPSÿ
+};
+
+const ShaderQualityPreset& shaderQualityPreset(ShaderQuality quality);
+
+// ע #version ֮ĺ궨飻_Speed/_Size Ӱ컭۶ǻʣɫĬֵ
+std::string shaderQualityDefines(ShaderQuality quality);
+
+// ƣlow/medium/high/ultraʧʱ false
+bool parseShaderQuality(const std::string& name, ShaderQuality& quality);
@@ -3,8 +3,8 @@
 #include <string>
 #include <iostream>
 
-// ȡɫļ
-std::string readShaderFile(const char* filePath)
+// ȡļݣʧʱӡ󲢷ؿַ
+static std::string readTextFile(const std::string& filePath)
 {
     std::string shaderCode;
     std::ifstream shaderFile;
@@ -30,4 +30,69 @@ std::string readShaderFile(const char* filePath)
     }
 
     return shaderCode;
+}
+
+// ׵ #include "file" 滻Ϊļݣ·ڵǰļĿ¼ļԼ #include
+static std::string expandShaderIncludes(const std::string& source, const std::string& directory, int depth)
+{
+    // 
+    if (depth > 8)
+    {
+        std::cout << "ɫ #include Ƕ׹ܴѭ" << std::endl;
+        return source;
+    }
+
+    std::string result;
+    size_t lineStart = 0;
+    while (lineStart < source.size())
+    {
+        size_t lineEnd = source.find('\n', lineStart);
+        if (lineEnd == std::string::npos)
+            lineEnd = source.size();
+        std::string line = source.substr(lineStart, lineEnd - lineStart);
+
+        size_t first = line.find_first_not_of(" \t");
+        size_t open = line.find('"');
+        size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+        if (first != std::string::npos && line.compare(first, 8, "#include") == 0 && close != std::string::npos)
+        {
+            std::string path = directory + line.substr(open + 1, close - open - 1);
+            size_t slash = path.find_last_of("/\\");
+            std::string included = readTextFile(path);
+            result += expandShaderIncludes(included, slash == std::string::npos ? "" : path.substr(0, slash + 1), depth + 1);
+            if (!included.empty() && included.back() != '\n')
+                result += '\n';
+        }
+        else
+        {
+            result += line;
+            if (lineEnd < source.size())
+                result += '\n';
+        }
+        lineStart = lineEnd + 1;
+    }
+    return result;
+}
+
+// ȡɫļݣչе #include
+std::string readShaderFile(const char* filePath)
+{
+    std::string path = filePath;
+    size_t slash = path.find_last_of("/\\");
+    return expandShaderIncludes(readTextFile(path), slash == std::string::npos ? "" : path.substr(0, slash + 1), 0);
+}
+
+//  #version ֮궨壨#version ɫĵһ䣩
+std::string injectShaderDefines(const std::string& source, const std::string& defines)
+{
+    if (defines.empty())
+        return source;
+
+    size_t versionPos = source.find("#version");
+    if (versionPos == std::string::npos)
+        return defines + source;
+    size_t lineEnd = source.find('\n', versionPos);
+    if (lineEnd == std::string::npos)
+        return source + "\n" + defines;
+    return source.substr(0, lineEnd + 1) + defines + source.substr(lineEnd + 1);
 }
\ No newline at end of file
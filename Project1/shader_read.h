@@ -1,4 +1,9 @@
 #pragma once
 #include <string> 
 
-std::string readShaderFile(const char* filePath);
\ No newline at end of file
+// ȡɫԴ룬׵ #include "file" ᱻ滻Ϊļݣ·ڰļ
+// ƻ水չԴ޸ıļͬᴥ±
+std::string readShaderFile(const char* filePath);
+
+//  #version ֮궨飬 "#define LENSING_LUT\n"
+std::string injectShaderDefines(const std::string& source, const std::string& defines);
\ No newline at end of file
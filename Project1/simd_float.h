@@ -0,0 +1,266 @@
+#pragma once
+// CPU Ⱦõ SIMD һδ FloatPack::Lanes ء
+// ѡԶѡˣAVX-51216 ·/ AVX28 ·/ SSE24 ·/ 飨4 ·
+// ǰ SIMD_TARGET_AVX2 ʱǿ AVX2߸ AVX2 Щ cpu_renderer_avx2.cpp
+// жռУͬһԲͬ˱ĸͻ
+// Խֻ㡢floor/round ͱȽϣ˹ͬһʵ֡
+#include <cmath>
+
+#if defined(__AVX512F__)
+#define SIMD_BACKEND_AVX512 1
+#include <immintrin.h>
+#elif defined(__AVX2__) || defined(SIMD_TARGET_AVX2)
+#define SIMD_BACKEND_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define SIMD_BACKEND_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+#if defined(SIMD_BACKEND_AVX512)
+
+struct MaskPack
+{
+    __mmask16 m;
+};
+
+struct FloatPack
+{
+    static const int Lanes = 16;
+    __m512 v;
+
+    FloatPack() : v(_mm512_setzero_ps()) {}
+    FloatPack(float s) : v(_mm512_set1_ps(s)) {}
+    FloatPack(__m512 x) : v(x) {}
+
+    static FloatPack load(const float* p) { return _mm512_loadu_ps(p); }
+    void store(float* p) const { _mm512_storeu_ps(p, v); }
+};
+
+inline FloatPack operator+(FloatPack a, FloatPack b) { return _mm512_add_ps(a.v, b.v); }
+inline FloatPack operator-(FloatPack a, FloatPack b) { return _mm512_sub_ps(a.v, b.v); }
+inline FloatPack operator*(FloatPack a, FloatPack b) { return _mm512_mul_ps(a.v, b.v); }
+inline FloatPack operator/(FloatPack a, FloatPack b) { return _mm512_div_ps(a.v, b.v); }
+inline FloatPack operator-(FloatPack a) { return _mm512_sub_ps(_mm512_setzero_ps(), a.v); }
+inline FloatPack min(FloatPack a, FloatPack b) { return _mm512_min_ps(a.v, b.v); }
+inline FloatPack max(FloatPack a, FloatPack b) { return _mm512_max_ps(a.v, b.v); }
+inline FloatPack sqrt(FloatPack a) { return _mm512_sqrt_ps(a.v); }
+inline FloatPack abs(FloatPack a) { return _mm512_abs_ps(a.v); }
+inline FloatPack floor(FloatPack a) { return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+inline FloatPack round(FloatPack a) { return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+inline MaskPack operator<(FloatPack a, FloatPack b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ) }; }
+inline MaskPack operator>(FloatPack a, FloatPack b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ) }; }
+inline MaskPack operator<=(FloatPack a, FloatPack b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ) }; }
+inline MaskPack operator&(MaskPack a, MaskPack b) { return { (__mmask16)(a.m & b.m) }; }
+inline MaskPack operator|(MaskPack a, MaskPack b) { return { (__mmask16)(a.m | b.m) }; }
+inline MaskPack operator~(MaskPack a) { return { (__mmask16)~a.m }; }
+inline MaskPack noneMask() { return { 0 }; }
+inline bool any(MaskPack a) { return a.m != 0; }
+inline bool all(MaskPack a) { return a.m == 0xFFFF; }
+inline bool laneSet(MaskPack a, int lane) { return (a.m >> lane) & 1; }
+// mask Ϊͨȡ aȡ b
+inline FloatPack blend(MaskPack mask, FloatPack a, FloatPack b) { return _mm512_mask_blend_ps(mask.m, b.v, a.v); }
+
+#elif defined(SIMD_BACKEND_AVX2)
+
+struct MaskPack
+{
+    __m256 m;
+};
+
+struct FloatPack
+{
+    static const int Lanes = 8;
+    __m256 v;
+
+    FloatPack() : v(_mm256_setzero_ps()) {}
+    FloatPack(float s) : v(_mm256_set1_ps(s)) {}
+    FloatPack(__m256 x) : v(x) {}
+
+    static FloatPack load(const float* p) { return _mm256_loadu_ps(p); }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+
+inline FloatPack operator+(FloatPack a, FloatPack b) { return _mm256_add_ps(a.v, b.v); }
+inline FloatPack operator-(FloatPack a, FloatPack b) { return _mm256_sub_ps(a.v, b.v); }
+inline FloatPack operator*(FloatPack a, FloatPack b) { return _mm256_mul_ps(a.v, b.v); }
+inline FloatPack operator/(FloatPack a, FloatPack b) { return _mm256_div_ps(a.v, b.v); }
+inline FloatPack operator-(FloatPack a) { return _mm256_sub_ps(_mm256_setzero_ps(), a.v); }
+inline FloatPack min(FloatPack a, FloatPack b) { return _mm256_min_ps(a.v, b.v); }
+inline FloatPack max(FloatPack a, FloatPack b) { return _mm256_max_ps(a.v, b.v); }
+inline FloatPack sqrt(FloatPack a) { return _mm256_sqrt_ps(a.v); }
+inline FloatPack abs(FloatPack a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+inline FloatPack floor(FloatPack a) { return _mm256_floor_ps(a.v); }
+inline FloatPack round(FloatPack a) { return _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+inline MaskPack operator<(FloatPack a, FloatPack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline MaskPack operator>(FloatPack a, FloatPack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline MaskPack operator<=(FloatPack a, FloatPack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+inline MaskPack operator&(MaskPack a, MaskPack b) { return { _mm256_and_ps(a.m, b.m) }; }
+inline MaskPack operator|(MaskPack a, MaskPack b) { return { _mm256_or_ps(a.m, b.m) }; }
+inline MaskPack operator~(MaskPack a) { return { _mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))) }; }
+inline MaskPack noneMask() { return { _mm256_setzero_ps() }; }
+inline bool any(MaskPack a) { return _mm256_movemask_ps(a.m) != 0; }
+inline bool all(MaskPack a) { return _mm256_movemask_ps(a.m) == 0xFF; }
+inline bool laneSet(MaskPack a, int lane) { return (_mm256_movemask_ps(a.m) >> lane) & 1; }
+// mask Ϊͨȡ aȡ b
+inline FloatPack blend(MaskPack mask, FloatPack a, FloatPack b) { return _mm256_blendv_ps(b.v, a.v, mask.m); }
+
+#elif defined(SIMD_BACKEND_SSE2)
+
+struct MaskPack
+{
+    __m128 m;
+};
+
+struct FloatPack
+{
+    static const int Lanes = 4;
+    __m128 v;
+
+    FloatPack() : v(_mm_setzero_ps()) {}
+    FloatPack(float s) : v(_mm_set1_ps(s)) {}
+    FloatPack(__m128 x) : v(x) {}
+
+    static FloatPack load(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+inline FloatPack operator+(FloatPack a, FloatPack b) { return _mm_add_ps(a.v, b.v); }
+inline FloatPack operator-(FloatPack a, FloatPack b) { return _mm_sub_ps(a.v, b.v); }
+inline FloatPack operator*(FloatPack a, FloatPack b) { return _mm_mul_ps(a.v, b.v); }
+inline FloatPack operator/(FloatPack a, FloatPack b) { return _mm_div_ps(a.v, b.v); }
+inline FloatPack operator-(FloatPack a) { return _mm_sub_ps(_mm_setzero_ps(), a.v); }
+inline FloatPack min(FloatPack a, FloatPack b) { return _mm_min_ps(a.v, b.v); }
+inline FloatPack max(FloatPack a, FloatPack b) { return _mm_max_ps(a.v, b.v); }
+inline FloatPack sqrt(FloatPack a) { return _mm_sqrt_ps(a.v); }
+inline FloatPack abs(FloatPack a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+// SSE2 û floorضϺԸΧԶС 2^31
+inline FloatPack floor(FloatPack a)
+{
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f)));
+}
+inline FloatPack round(FloatPack a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)); }
+
+inline MaskPack operator<(FloatPack a, FloatPack b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline MaskPack operator>(FloatPack a, FloatPack b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline MaskPack operator<=(FloatPack a, FloatPack b) { return { _mm_cmple_ps(a.v, b.v) }; }
+inline MaskPack operator&(MaskPack a, MaskPack b) { return { _mm_and_ps(a.m, b.m) }; }
+inline MaskPack operator|(MaskPack a, MaskPack b) { return { _mm_or_ps(a.m, b.m) }; }
+inline MaskPack operator~(MaskPack a) { return { _mm_xor_ps(a.m, _mm_castsi128_ps(_mm_set1_epi32(-1))) }; }
+inline MaskPack noneMask() { return { _mm_setzero_ps() }; }
+inline bool any(MaskPack a) { return _mm_movemask_ps(a.m) != 0; }
+inline bool all(MaskPack a) { return _mm_movemask_ps(a.m) == 0xF; }
+inline bool laneSet(MaskPack a, int lane) { return (_mm_movemask_ps(a.m) >> lane) & 1; }
+// mask Ϊͨȡ aȡ b
+inline FloatPack blend(MaskPack mask, FloatPack a, FloatPack b) { return _mm_or_ps(_mm_and_ps(mask.m, a.v), _mm_andnot_ps(mask.m, b.v)); }
+
+#else
+
+struct MaskPack
+{
+    bool m[4];
+};
+
+struct FloatPack
+{
+    static const int Lanes = 4;
+    float v[Lanes];
+
+    FloatPack() { for (int i = 0; i < Lanes; i++) v[i] = 0.0f; }
+    FloatPack(float s) { for (int i = 0; i < Lanes; i++) v[i] = s; }
+
+    static FloatPack load(const float* p) { FloatPack r; for (int i = 0; i < Lanes; i++) r.v[i] = p[i]; return r; }
+    void store(float* p) const { for (int i = 0; i < Lanes; i++) p[i] = v[i]; }
+};
+
+#define SIMD_SCALAR_BINARY(name, expr) \
+    inline FloatPack name(FloatPack a, FloatPack b) { FloatPack r; for (int i = 0; i < FloatPack::Lanes; i++) { float x = a.v[i], y = b.v[i]; r.v[i] = (expr); } return r; }
+#define SIMD_SCALAR_UNARY(name, expr) \
+    inline FloatPack name(FloatPack a) { FloatPack r; for (int i = 0; i < FloatPack::Lanes; i++) { float x = a.v[i]; r.v[i] = (expr); } return r; }
+#define SIMD_SCALAR_COMPARE(name, expr) \
+    inline MaskPack name(FloatPack a, FloatPack b) { MaskPack r; for (int i = 0; i < FloatPack::Lanes; i++) { float x = a.v[i], y = b.v[i]; r.m[i] = (expr); } return r; }
+
+SIMD_SCALAR_BINARY(operator+, x + y)
+SIMD_SCALAR_BINARY(operator-, x - y)
+SIMD_SCALAR_BINARY(operator*, x * y)
+SIMD_SCALAR_BINARY(operator/, x / y)
+SIMD_SCALAR_BINARY(min, y < x ? y : x)
+SIMD_SCALAR_BINARY(max, y > x ? y : x)
+SIMD_SCALAR_UNARY(operator-, -x)
+SIMD_SCALAR_UNARY(sqrt, std::sqrt(x))
+SIMD_SCALAR_UNARY(abs, std::fabs(x))
+SIMD_SCALAR_UNARY(floor, std::floor(x))
+SIMD_SCALAR_UNARY(round, std::nearbyint(x))
+SIMD_SCALAR_COMPARE(operator<, x < y)
+SIMD_SCALAR_COMPARE(operator>, x > y)
+SIMD_SCALAR_COMPARE(operator<=, x <= y)
+
+#undef SIMD_SCALAR_BINARY
+#undef SIMD_SCALAR_UNARY
+#undef SIMD_SCALAR_COMPARE
+
+inline MaskPack operator&(MaskPack a, MaskPack b) { MaskPack r; for (int i = 0; i < 4; i++) r.m[i] = a.m[i] && b.m[i]; return r; }
+inline MaskPack operator|(MaskPack a, MaskPack b) { MaskPack r; for (int i = 0; i < 4; i++) r.m[i] = a.m[i] || b.m[i]; return r; }
+inline MaskPack operator~(MaskPack a) { MaskPack r; for (int i = 0; i < 4; i++) r.m[i] = !a.m[i]; return r; }
+inline MaskPack noneMask() { return { { false, false, false, false } }; }
+inline bool any(MaskPack a) { return a.m[0] || a.m[1] || a.m[2] || a.m[3]; }
+inline bool all(MaskPack a) { return a.m[0] && a.m[1] && a.m[2] && a.m[3]; }
+inline bool laneSet(MaskPack a, int lane) { return a.m[lane]; }
+// mask Ϊͨȡ aȡ b
+inline FloatPack blend(MaskPack mask, FloatPack a, FloatPack b) { FloatPack r; for (int i = 0; i < 4; i++) r.v[i] = mask.m[i] ? a.v[i] : b.v[i]; return r; }
+
+#endif
+
+// ----  GLSL ڽӦͨʵ ----
+
+inline FloatPack fract(FloatPack x) { return x - floor(x); }
+inline FloatPack clamp(FloatPack x, FloatPack lo, FloatPack hi) { return min(max(x, lo), hi); }
+inline FloatPack mix(FloatPack a, FloatPack b, FloatPack t) { return a + (b - a) * t; }
+
+// sin pi  Cody-Waite Լ [-pi/2, pi/2] ϵ 13 ̩նʽԼ 1 ulp
+// sin ϣŴ 1.5e5 Ȳʱǵӻ GPU ͬ
+inline FloatPack sin(FloatPack x)
+{
+    FloatPack k = round(x * FloatPack(0.318309886f));
+    FloatPack r = x - k * FloatPack(3.140625f);
+    r = r - k * FloatPack(9.67502593994140625e-4f);
+    r = r - k * FloatPack(1.509957990978376432e-7f);
+
+    FloatPack r2 = r * r;
+    FloatPack p = FloatPack(1.6059044e-10f);
+    p = p * r2 + FloatPack(-2.5052108e-8f);
+    p = p * r2 + FloatPack(2.7557319e-6f);
+    p = p * r2 + FloatPack(-1.98412698e-4f);
+    p = p * r2 + FloatPack(8.33333333e-3f);
+    p = p * r2 + FloatPack(-1.66666667e-1f);
+    p = r + r * r2 * p;
+
+    // k Ϊʱȡ
+    FloatPack half = k * FloatPack(0.5f);
+    MaskPack odd = FloatPack(0.25f) < abs(half - floor(half));
+    return blend(odd, -p, p);
+}
+
+// atan x >= 0 +infx > 1 ʱ pi/2 - atan(1/x)
+inline FloatPack atanPositive(FloatPack x)
+{
+    MaskPack big = FloatPack(1.0f) < x;
+    FloatPack t = blend(big, FloatPack(1.0f) / x, x);
+    FloatPack t2 = t * t;
+    FloatPack p = FloatPack(-0.01172120f);
+    p = p * t2 + FloatPack(0.05265332f);
+    p = p * t2 + FloatPack(-0.11643287f);
+    p = p * t2 + FloatPack(0.19354346f);
+    p = p * t2 + FloatPack(-0.33262347f);
+    p = p * t2 + FloatPack(0.99997726f);
+    p = p * t;
+    return blend(big, FloatPack(1.57079633f) - p, p);
+}
+
+}
@@ -0,0 +1,87 @@
+#include <glad/glad.h>
+#include <iostream>
+#include <vector>
+#include "step_counter.h"
+
+static void deleteTargets(StepCounter& counter)
+{
+    glDeleteTextures(1, &counter.stepsTex);
+    counter.stepsTex = 0;
+    if (counter.target.fbo != 0)
+        deleteRenderTarget(counter.target);
+}
+
+static bool createTargets(StepCounter& counter, int width, int height)
+{
+    if (!createRenderTarget(counter.target, width, height, GL_RGBA8))
+        return false;
+
+    glGenTextures(1, &counter.stepsTex);
+    glBindTexture(GL_TEXTURE_2D, counter.stepsTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, counter.target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, counter.stepsTex, 0);
+    GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+
+    // 
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete)
+    {
+        std::cout << "ͳ֡岻" << std::endl;
+        deleteTargets(counter);
+    }
+    return complete;
+}
+
+void deleteStepCounter(StepCounter& counter)
+{
+    deleteTargets(counter);
+    counter = StepCounter();
+}
+
+bool beginStepCounter(StepCounter& counter, int width, int height)
+{
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &counter.outputFbo);
+    glGetIntegerv(GL_VIEWPORT, counter.outputViewport);
+
+    if (counter.target.width != width || counter.target.height != height)
+    {
+        deleteTargets(counter);
+        if (!createTargets(counter, width, height))
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, counter.outputFbo);
+            return false;
+        }
+    }
+    bindRenderTarget(counter.target);
+    return true;
+}
+
+void endStepCounter(StepCounter& counter)
+{
+    const RenderTarget& target = counter.target;
+    std::vector<float> steps(static_cast<size_t>(target.width) * target.height);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    glReadPixels(0, 0, target.width, target.height, GL_RED, GL_FLOAT, steps.data());
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+    double sum = 0.0;
+    for (float s : steps)
+        sum += s;
+    counter.averageSteps = sum / steps.size();
+    counter.stepsSum += counter.averageSteps;
+    counter.countedFrames++;
+
+    const int* viewport = counter.outputViewport;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, target.fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, counter.outputFbo);
+    glBlitFramebuffer(0, 0, target.width, target.height, viewport[0], viewport[1],
+        viewport[0] + viewport[2], viewport[1] + viewport[3], GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, counter.outputFbo);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "render_target.h"
+
+// ֲͳƣ--count-stepsÿÿߵĻֲR32F
+// ȾԼĿ꣬ʱز֡ƽٰɫƵߵ֡塣
+// ػȴ GPUֻͳʱ
+struct StepCounter
+{
+    RenderTarget target;        // ɫ
+    unsigned int stepsTex = 0;  // Ϊ GL_COLOR_ATTACHMENT1
+
+    // ߵ֡ӿڣʱƻȥ
+    int outputFbo = 0;
+    int outputViewport[4] = {};
+
+    double averageSteps = 0.0;  // һ֡ÿߵƽ
+    double stepsSum = 0.0;
+    long long countedFrames = 0;
+};
+
+void deleteStepCounter(StepCounter& counter);
+
+// µߵ֡ӿڣߴ仯ʱ·Ŀ꣩󶨴Ŀ
+bool beginStepCounter(StepCounter& counter, int width, int height);
+// ز averageStepsɫƵߵ֡岢ָӿ
+void endStepCounter(StepCounter& counter);
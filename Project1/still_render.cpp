@@ -0,0 +1,205 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "still_render.h"
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+#include "image_write.h"
+
+// ֿȾ϶һ飩ȾÿۻصĶӦУ
+// ں̨߳дļͬʱ GPU ȾһGPU ֻһСĿۻ
+static int renderTiledStill(BlackholeRenderer& renderer, const RenderConfig& config)
+{
+    int tile = config.stillTile;
+    int columns = (config.width + tile - 1) / tile;
+    int bands = (config.height + tile - 1) / tile;
+    RenderTarget target;
+    if (!createRenderTarget(target, std::min(tile, config.width), std::min(tile, config.height), GL_RGBA8))
+        return -1;
+
+    std::string path = formatFramePath(config.output, 0);
+    ImageStreamPPM stream;
+    if (!beginImagePPM(stream, path, config.width, config.height))
+    {
+        deleteRenderTarget(target);
+        return -1;
+    }
+
+    // ֻһдļһն
+    std::vector<unsigned char> bandPixels[2];
+    for (int i = 0; i < 2; i++)
+        bandPixels[i].resize(static_cast<size_t>(config.width) * target.height * 3);
+    std::future<bool> pendingWrite;
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ROW_LENGTH, config.width);
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    // ʱԤƽָÿһ飬ˮƽڿ֮
+    double tileSeconds = config.stillSeconds > 0.0f ? config.stillSeconds / (static_cast<double>(columns) * bands) : 0.0;
+    int minSamples = config.stillSamples;
+    int result = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int band = 0; band < bands && result == 0; band++)
+    {
+        // glReadPixels ¶ϣһͼһ
+        int top = config.height - band * tile;
+        int bandHeight = std::min(tile, top);
+        int y = top - bandHeight;
+        std::vector<unsigned char>& pixels = bandPixels[band % 2];
+
+        for (int column = 0; column < columns; column++)
+        {
+            int x = column * tile;
+            int tileWidth = std::min(tile, config.width - x);
+            bindRenderTarget(target);
+            glViewport(0, 0, tileWidth, bandHeight);
+            setBlackholeRegion(renderer, x, y, tileWidth, bandHeight);
+
+            auto tileStart = std::chrono::steady_clock::now();
+            int samples = 0;
+            while (samples < config.stillSamples)
+            {
+                drawBlackhole(renderer, config.startTime, w, h, config.mouseX * w, config.mouseY * h);
+                samples++;
+                if (tileSeconds > 0.0)
+                {
+                    glFinish();
+                    if (std::chrono::duration<double>(std::chrono::steady_clock::now() - tileStart).count() >= tileSeconds)
+                        break;
+                }
+            }
+            minSamples = std::min(minSamples, samples);
+
+            // PACK_ROW_LENGTH Ϊȣһֱĵ x 
+            bindRenderTarget(target);
+            glReadPixels(0, 0, tileWidth, bandHeight, GL_RGB, GL_UNSIGNED_BYTE, pixels.data() + static_cast<size_t>(x) * 3);
+        }
+
+        // һд֮ǰܿʼдһļ˳׷ӣ
+        if (pendingWrite.valid() && !pendingWrite.get())
+        {
+            result = -1;
+            break;
+        }
+        pendingWrite = std::async(std::launch::async, [&stream, &pixels, bandHeight]()
+        {
+            return writeImageRowsPPM(stream, pixels.data(), bandHeight, true);
+        });
+        std::cout << " " << band + 1 << " / " << bands << " ɣ" << bandHeight << " У" << std::endl;
+    }
+
+    if (pendingWrite.valid() && !pendingWrite.get())
+        result = -1;
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    if (!endImagePPM(stream))
+        result = -1;
+    deleteRenderTarget(target);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (result == 0)
+        std::cout << "д룺" << path << "" << config.width << "x" << config.height << "" << columns << "x" << bands
+            << " 飬ÿ " << minSamples << " /أ" << seconds << " s" << std::endl;
+    return result;
+}
+
+int runStillRender(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return -1;
+
+    std::cout << "GL_RENDERER" << glGetString(GL_RENDERER) << std::endl;
+
+    BlackholeRenderer renderer;
+    if (!createBlackholeRenderer(renderer, config, vertexSource, fragmentSource))
+    {
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    if (!renderer.accumulate || (config.stillTile > 0 && !renderer.region))
+    {
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    if (renderer.region)
+    {
+        int result = renderTiledStill(renderer, config);
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return result;
+    }
+
+    RenderTarget target;
+    if (!createRenderTarget(target, config.width, config.height, GL_RGBA8))
+    {
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(config.width) * config.height * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    std::string path = formatFramePath(config.output, 0);
+
+    // صǰƽֵдļۻÿλƺѽ target
+    auto writeStill = [&]()
+    {
+        bindRenderTarget(target);
+        glReadPixels(0, 0, config.width, config.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        return writeImagePPM(path, config.width, config.height, pixels.data(), true);
+    };
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    int result = 0;
+    auto start = std::chrono::steady_clock::now();
+    double seconds = 0.0;
+    int samples = 0;
+
+    while (samples < config.stillSamples)
+    {
+        bindRenderTarget(target);
+        drawBlackhole(renderer, config.startTime, w, h, config.mouseX * w, config.mouseY * h);
+        samples++;
+
+        // ÿ GPU ɣʱԤ㰴ʵȾʱ㣬ֹͣʱŶδɵ
+        glFinish();
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bool last = samples >= config.stillSamples || (config.stillSeconds > 0.0f && seconds >= config.stillSeconds);
+
+        if (!last && config.stillPreview > 0 && samples % config.stillPreview == 0)
+        {
+            if (!writeStill())
+            {
+                result = -1;
+                break;
+            }
+            std::cout << "дм" << path << "" << samples << " /أ" << seconds << " s" << std::endl;
+        }
+        if (last)
+            break;
+    }
+
+    if (result == 0)
+    {
+        if (writeStill())
+            std::cout << "д룺" << path << "" << samples << " /أ" << seconds << " s"
+                << samples / seconds << " /s" << std::endl;
+        else
+            result = -1;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    deleteRenderTarget(target);
+    deleteBlackholeRenderer(renderer);
+    destroyOffscreenContext(ctx);
+    return result;
+}
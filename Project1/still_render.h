@@ -0,0 +1,9 @@
+#pragma once
+#include "render_config.h"
+
+// ֡ģʽ--still EGL й̶ config.startTime  config.mouseX/mouseY
+// ýۻaccumulation.hӣ stillSamples  stillSeconds д output ĵ 0 ֡
+// stillPreview > 0 ʱÿôѵǰƽֵдͬһļ
+// stillTile > 0 ʱֿȾ setBlackholeRegionۻʽдļ
+// GPU ֻһСĿ꣬Ⱦ GL_MAX_TEXTURE_SIZE ķֱʣʱԤƽָÿһ飬дм
+int runStillRender(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "task_scheduler.h"
+
+// ÿ̵߳ı
+struct WorkQueue
+{
+    std::mutex mutex;
+    std::deque<int> tasks;
+};
+
+static bool popLocal(WorkQueue& queue, int& task)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+static bool steal(WorkQueue& queue, int& task)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+    task = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+void parallelForWorkStealing(int taskCount, int threadCount, const std::function<void(int, int)>& fn)
+{
+    threadCount = std::max(1, std::min(threadCount, taskCount));
+    if (threadCount <= 1)
+    {
+        for (int task = 0; task < taskCount; task++)
+            fn(task, 0);
+        return;
+    }
+
+    // 䣬ƬĻֲ
+    std::vector<WorkQueue> queues(threadCount);
+    for (int w = 0; w < threadCount; w++)
+    {
+        int begin = static_cast<int>(static_cast<long long>(taskCount) * w / threadCount);
+        int end = static_cast<int>(static_cast<long long>(taskCount) * (w + 1) / threadCount);
+        // 룬ʹ popLocal 俪ͷʼ
+        for (int task = end - 1; task >= begin; task--)
+            queues[w].tasks.push_back(task);
+    }
+
+    auto worker = [&](int w)
+    {
+        int task;
+        for (;;)
+        {
+            if (popLocal(queues[w], task))
+            {
+                fn(task, w);
+                continue;
+            }
+            // 񲻻жжռ
+            bool stolen = false;
+            for (int i = 1; i < threadCount && !stolen; i++)
+                stolen = steal(queues[(w + i) % threadCount], task);
+            if (!stolen)
+                return;
+            fn(task, w);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int w = 1; w < threadCount; w++)
+        threads.emplace_back(worker, w);
+    worker(0);
+    for (auto& t : threads)
+        t.join();
+}
+
+int hardwareThreadCount()
+{
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<int>(n);
+}
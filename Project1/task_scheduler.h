@@ -0,0 +1,10 @@
+#pragma once
+#include <functional>
+
+// ȡѭ [0, taskCount) Ȱ̵ָ߳ıضУ
+// ̴߳Լβȡ񣬱ضп˾ʹ̶߳ͷȡ
+// fn(task, worker)worker Ϊ [0, threadCount)߳Ϊ worker 0 롣
+void parallelForWorkStealing(int taskCount, int threadCount, const std::function<void(int, int)>& fn);
+
+// Ӳ߳Ϊ 1
+int hardwareThreadCount();
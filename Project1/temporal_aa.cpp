@@ -0,0 +1,141 @@
+#include <glad/glad.h>
+#include <iostream>
+#include <string>
+#include "temporal_aa.h"
+#include "shader_read.h"
+
+// Halton е index index  1 ʼ
+static float halton(int index, int base)
+{
+    float result = 0.0f;
+    float fraction = 1.0f;
+    while (index > 0)
+    {
+        fraction /= base;
+        result += fraction * (index % base);
+        index /= base;
+    }
+    return result;
+}
+
+bool createTemporalAA(TemporalAA& taa, const char* vertexSource, const char* fragmentSource)
+{
+    std::string fragment = injectShaderDefines(fragmentSource, "#define TAA_RESOLVE\n");
+    taa.resolve = createBlackholeProgram(vertexSource, fragment.c_str());
+    return taa.resolve.program != 0;
+}
+
+static void deleteTargets(TemporalAA& taa)
+{
+    if (taa.current.fbo != 0)
+        deleteRenderTarget(taa.current);
+    glDeleteTextures(1, &taa.motionTex);
+    taa.motionTex = 0;
+    for (int i = 0; i < 2; i++)
+    {
+        if (taa.history[i].fbo != 0)
+            deleteRenderTarget(taa.history[i]);
+    }
+    taa.historyValid = false;
+}
+
+void deleteTemporalAA(TemporalAA& taa)
+{
+    deleteTargets(taa);
+    deleteBlackholeProgram(taa.resolve);
+    taa = TemporalAA();
+}
+
+void temporalAAJitter(const TemporalAA& taa, float& x, float& y)
+{
+    int index = static_cast<int>(taa.frame % TaaJitterCount) + 1;
+    x = halton(index, 2) - 0.5f;
+    y = halton(index, 3) - 0.5f;
+}
+
+bool beginTemporalAA(TemporalAA& taa, int width, int height)
+{
+    if (taa.current.width != width || taa.current.height != height)
+    {
+        deleteTargets(taa);
+        // 뾫ȸ㣺ʷϣ8 λɫ
+        if (!createRenderTarget(taa.current, width, height, GL_RGBA16F) ||
+            !createRenderTarget(taa.history[0], width, height, GL_RGBA16F) ||
+            !createRenderTarget(taa.history[1], width, height, GL_RGBA16F))
+        {
+            deleteTargets(taa);
+            return false;
+        }
+
+        // ݷҪ֣뾫ȵһصķͬ 32 λ
+        glGenTextures(1, &taa.motionTex);
+        glBindTexture(GL_TEXTURE_2D, taa.motionTex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindFramebuffer(GL_FRAMEBUFFER, taa.current.fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, taa.motionTex, 0);
+        const GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glDrawBuffers(2, drawBuffers);
+        // 
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            std::cout << "ʱ俹֡岻" << std::endl;
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            deleteTargets(taa);
+            return false;
+        }
+    }
+    bindRenderTarget(taa.current);
+    return true;
+}
+
+void resolveTemporalAA(TemporalAA& taa, const FullscreenQuad& quad, float time, float mouseX, float mouseY,
+    unsigned int outputFbo, const int outputViewport[4])
+{
+    const RenderTarget& previous = taa.history[taa.historyIndex];
+    const RenderTarget& next = taa.history[1 - taa.historyIndex];
+    float w = static_cast<float>(taa.current.width);
+    float h = static_cast<float>(taa.current.height);
+
+    bindRenderTarget(next);
+    useBlackholeProgram(taa.resolve, time, w, h, mouseX, mouseY);
+    unsigned int program = taa.resolve.program;
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, taa.current.colorTex);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, previous.colorTex);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, taa.motionTex);
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(glGetUniformLocation(program, "iCurrent"), 0);
+    glUniform1i(glGetUniformLocation(program, "iHistory"), 1);
+    glUniform1i(glGetUniformLocation(program, "iMotion"), 2);
+    glUniform1f(glGetUniformLocation(program, "iPrevTime"), taa.prevTime);
+    glUniform2f(glGetUniformLocation(program, "iPrevMouse"), taa.prevMouseX, taa.prevMouseY);
+    glUniform1f(glGetUniformLocation(program, "iBlend"), taa.blend);
+    glUniform1f(glGetUniformLocation(program, "iMotionBlend"), taa.motionBlend);
+    glUniform1f(glGetUniformLocation(program, "iClipBlend"), taa.motionClipBlend);
+    float jitterX, jitterY;
+    temporalAAJitter(taa, jitterX, jitterY);
+    glUniform2f(glGetUniformLocation(program, "iJitter"), jitterX, jitterY);
+    glUniform1i(glGetUniformLocation(program, "iHistoryValid"), taa.historyValid ? 1 : 0);
+    drawFullscreenQuad(quad);
+
+    // ԭ󶨵֡
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, next.fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, outputFbo);
+    glBlitFramebuffer(0, 0, next.width, next.height, outputViewport[0], outputViewport[1],
+        outputViewport[0] + outputViewport[2], outputViewport[1] + outputViewport[3], GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, outputFbo);
+    glViewport(outputViewport[0], outputViewport[1], outputViewport[2], outputViewport[3]);
+
+    taa.historyIndex = 1 - taa.historyIndex;
+    taa.historyValid = true;
+    taa.prevTime = time;
+    taa.prevMouseX = mouseX;
+    taa.prevMouseY = mouseY;
+    taa.frame++;
+}
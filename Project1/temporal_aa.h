@@ -0,0 +1,43 @@
+#pragma once
+#include "blackhole_pass.h"
+#include "fullscreen_quad.h"
+#include "render_target.h"
+
+// гȣHalton(2,3) ǰ 8 
+const int TaaJitterCount = 8;
+
+// ʱ俹ݣ--taaÿֻ֡׷һضĹߣAA ǿΪ 1ʷ֡ϡ澲ֹʱ
+// ֱۻ˶ʱ֡ȡ 3x3 ĵľȨĹƣͶӰʷϡڶ̵
+//  iTime 仯ʱֹÿصݷͶӰصͶӰǾȷģʷֱӻϣص
+// ʷǰ֡ 3x3  YCoCg ռľֵ׼üӰ
+struct TemporalAA
+{
+    RenderTarget current;       // ֡Ⱦa Ϊռȣ
+    unsigned int motionTex = 0; // current ĵڶɫݷRGBA32F blackhole.frag
+    RenderTarget history[2];    //  ping-pong
+    int historyIndex = 0;       // history[historyIndex] Ϊһ֡Ľ
+    bool historyValid = false;
+    BlackholeProgram resolve;
+    float blend = 0.1f;         // 澲ֹʱ֡ȨأԼۻ 1/blend ֡
+    // iTime  iMouse 仯ʱı֡ȨأÿͶӰزǵĨһ㣬̵ iTime ԭر仯
+    // ʷֻ֡
+    float motionBlend = 0.5f;       // 
+    float motionClipBlend = 0.75f;  // 
+
+    long long frame = 0;
+    float prevTime = 0.0f;
+    float prevMouseX = 0.0f;
+    float prevMouseY = 0.0f;
+};
+
+bool createTemporalAA(TemporalAA& taa, const char* vertexSource, const char* fragmentSource);
+void deleteTemporalAA(TemporalAA& taa);
+
+// ֡ضأΧ -0.5 ~ 0.5
+void temporalAAJitter(const TemporalAA& taa, float& x, float& y);
+
+// 󶨱֡ĶȾĿ꣨ߴ仯ʱ·䲢ʷʱӿΪ width x height
+bool beginTemporalAA(TemporalAA& taa, int width, int height);
+// µʷ岢Ƶ outputFbo  outputViewport mouseX/mouseY Ϊ
+void resolveTemporalAA(TemporalAA& taa, const FullscreenQuad& quad, float time, float mouseX, float mouseY,
+    unsigned int outputFbo, const int outputViewport[4]);
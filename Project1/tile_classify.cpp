@@ -0,0 +1,151 @@
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+#include "tile_classify.h"
+#include "shader_read.h"
+
+static void deleteTargets(TileClassifier& tiles)
+{
+    if (tiles.samples.fbo != 0)
+        deleteRenderTarget(tiles.samples);
+    if (tiles.tiles.fbo != 0)
+        deleteRenderTarget(tiles.tiles);
+    if (tiles.target.fbo != 0)
+        deleteRenderTarget(tiles.target);
+}
+
+static bool createTargets(TileClassifier& tiles, int width, int height)
+{
+    // Ƭ߳ǲƬ t ǲ [t*n, t*n + n)
+    int sampleWidth = (width + TileSampleSpacing - 1) / TileSampleSpacing;
+    int sampleHeight = (height + TileSampleSpacing - 1) / TileSampleSpacing;
+    int tileWidth = (width + TileSize - 1) / TileSize;
+    int tileHeight = (height + TileSize - 1) / TileSize;
+    if (!createRenderTarget(tiles.samples, sampleWidth, sampleHeight, GL_RGBA8) ||
+        !createRenderTarget(tiles.tiles, tileWidth, tileHeight, GL_RGBA8) ||
+        !createRenderTarget(tiles.target, width, height, GL_RGBA8) ||
+        !attachDepthStencil(tiles.target))
+    {
+        deleteTargets(tiles);
+        return false;
+    }
+    return true;
+}
+
+bool createTileClassifier(TileClassifier& tiles, const char* vertexSource, const char* fragmentSource)
+{
+    std::string fragment = injectShaderDefines(fragmentSource, "#define TILE_REDUCE\n");
+    tiles.reduce = createBlackholeProgram(vertexSource, fragment.c_str());
+    fragment = injectShaderDefines(fragmentSource, "#define TILE_STENCIL\n");
+    tiles.stencil = createBlackholeProgram(vertexSource, fragment.c_str());
+    return tiles.reduce.program != 0 && tiles.stencil.program != 0;
+}
+
+void deleteTileClassifier(TileClassifier& tiles)
+{
+    deleteTargets(tiles);
+    for (int i = 0; i < ShaderQualityCount; i++)
+    {
+        deleteBlackholeProgram(tiles.prepass[i]);
+        deleteBlackholeProgram(tiles.background[i]);
+        deleteBlackholeProgram(tiles.disk[i]);
+    }
+    deleteBlackholeProgram(tiles.reduce);
+    deleteBlackholeProgram(tiles.stencil);
+    tiles = TileClassifier();
+}
+
+bool beginTileClassify(TileClassifier& tiles, ShaderQuality quality, int width, int height,
+    float time, float mouseX, float mouseY)
+{
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &tiles.outputFbo);
+    glGetIntegerv(GL_VIEWPORT, tiles.outputViewport);
+
+    if (tiles.target.width != width || tiles.target.height != height)
+    {
+        deleteTargets(tiles);
+        if (!createTargets(tiles, width, height))
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, tiles.outputFbo);
+            return false;
+        }
+    }
+
+    // iResolution ȫֱʣɫ gl_FragCoord * iBlockSize λ
+    bindRenderTarget(tiles.samples);
+    const BlackholeProgram& prepass = tiles.prepass[static_cast<int>(quality)];
+    useBlackholeProgram(prepass, time, static_cast<float>(width), static_cast<float>(height), mouseX, mouseY);
+    glUniform1i(glGetUniformLocation(prepass.program, "iBlockSize"), TileSampleSpacing);
+    return true;
+}
+
+void classifyTiles(TileClassifier& tiles, const FullscreenQuad& quad)
+{
+    //  -> Ƭ
+    bindRenderTarget(tiles.tiles);
+    glUseProgram(tiles.reduce.program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, tiles.samples.colorTex);
+    glUniform1i(glGetUniformLocation(tiles.reduce.program, "iTileSamples"), 0);
+    glUniform1i(glGetUniformLocation(tiles.reduce.program, "iSamplesPerTile"), TileSize / TileSampleSpacing);
+    drawFullscreenQuad(quad);
+
+    // Ƭ -> ģ壺ģΪ 0ΰ >= 1>= 2 ظΪ 12
+    bindRenderTarget(tiles.target);
+    glClearStencil(0);
+    glClear(GL_STENCIL_BUFFER_BIT);
+    glEnable(GL_STENCIL_TEST);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glUseProgram(tiles.stencil.program);
+    glBindTexture(GL_TEXTURE_2D, tiles.tiles.colorTex);
+    glUniform1i(glGetUniformLocation(tiles.stencil.program, "iTileClasses"), 0);
+    glUniform1i(glGetUniformLocation(tiles.stencil.program, "iTileSize"), TileSize);
+    for (int tileClass = 1; tileClass < TileClassCount; tileClass++)
+    {
+        glStencilFunc(GL_ALWAYS, tileClass, 0xFF);
+        glUniform1f(glGetUniformLocation(tiles.stencil.program, "iTileClass"), static_cast<float>(tileClass));
+        drawFullscreenQuad(quad);
+    }
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+const BlackholeProgram& beginTileClass(TileClassifier& tiles, ShaderQuality quality, int tileClass,
+    const BlackholeProgram& full)
+{
+    glStencilFunc(GL_EQUAL, tileClass, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    if (tileClass == 0)
+        return tiles.background[static_cast<int>(quality)];
+    if (tileClass == 1)
+        return tiles.disk[static_cast<int>(quality)];
+    return full;
+}
+
+void endTileClassify(TileClassifier& tiles)
+{
+    glDisable(GL_STENCIL_TEST);
+
+    const int* viewport = tiles.outputViewport;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, tiles.target.fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, tiles.outputFbo);
+    glBlitFramebuffer(0, 0, tiles.target.width, tiles.target.height, viewport[0], viewport[1],
+        viewport[0] + viewport[2], viewport[1] + viewport[3], GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, tiles.outputFbo);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void countTileClasses(TileClassifier& tiles)
+{
+    std::vector<unsigned char> classes(static_cast<size_t>(tiles.tiles.width) * tiles.tiles.height * 4);
+    int previousFbo = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, tiles.tiles.fbo);
+    glReadPixels(0, 0, tiles.tiles.width, tiles.tiles.height, GL_RGBA, GL_UNSIGNED_BYTE, classes.data());
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+
+    //  * 0.5 Ϊ 8 λ0128255
+    for (size_t i = 0; i < classes.size(); i += 4)
+        tiles.tileCounts[classes[i] < 64 ? 0 : (classes[i] < 192 ? 1 : 2)]++;
+    tiles.countedFrames++;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "blackhole_pass.h"
+#include "fullscreen_quad.h"
+#include "render_target.h"
+#include "shader_quality.h"
+
+// Ƭ߳ࣨأÿƬ 4x4 
+const int TileSize = 16;
+const int TileSampleSpacing = 4;
+
+// Ƭͣͬʱģֵ0 ֻб1 ̣2 ɻþĹ
+const int TileClassCount = 3;
+
+// Ƭɣ--tile-classifyȰ TileSampleSpacing ׷٣ɫ̣
+// ԼÿƬͲдģ壬ٷֱȥӦ֧ĳÿһأ
+// Ƭ raymarchDiskƬжӽ磬ӽƬ
+struct TileClassifier
+{
+    RenderTarget samples;   // ÿ * 0.5
+    RenderTarget tiles;     // ÿƬ * 0.5
+    RenderTarget target;    // ȫֱʽ + ģ
+    BlackholeProgram prepass[ShaderQualityCount];       // ȾĻʱһһӦ
+    BlackholeProgram background[ShaderQualityCount];
+    BlackholeProgram disk[ShaderQualityCount];
+    BlackholeProgram reduce;
+    BlackholeProgram stencil;
+
+    // ߵ֡ӿڣʱƻȥ
+    int outputFbo = 0;
+    int outputViewport[4] = {};
+
+    long long tileCounts[TileClassCount] = {};  // countTileClasses ۼƵĸƬ
+    long long countedFrames = 0;
+};
+
+bool createTileClassifier(TileClassifier& tiles, const char* vertexSource, const char* fragmentSource);
+void deleteTileClassifier(TileClassifier& tiles);
+
+// µߵ֡ӿڣߴ仯ʱ·Ŀ꣩󶨲Ŀ겢ʹ quality Ӧķ
+// Դȫı
+bool beginTileClassify(TileClassifier& tiles, ShaderQuality quality, int width, int height,
+    float time, float mouseX, float mouseY);
+// ԼƬͲдȫֱĿģ壬ʱĿѰ󶨡ģѿ
+void classifyTiles(TileClassifier& tiles, const FullscreenQuad& quad);
+// ֮Ļֻ tileClass أظʹõĳ򣨺ӽƬ full
+const BlackholeProgram& beginTileClass(TileClassifier& tiles, ShaderQuality quality, int tileClass,
+    const BlackholeProgram& full);
+// رģԣѽƵߵ֡岢ָӿ
+void endTileClassify(TileClassifier& tiles);
+
+// ر֡ƬͲۼƵ tileCountsȴ GPUֻͳʱã
+void countTileClasses(TileClassifier& tiles);
@@ -0,0 +1,28 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 texCoord; // Ӷɫ
+
+// ֱ̬ʵķŴ passiSource ½ iSourceScale ǵͷֱʻ
+uniform sampler2D iSource;
+uniform vec2 iSourceScale;
+uniform float iSharpness;   // 0 Ϊ˫ԣ> 0 ʮηģ
+
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(iSource, 0));
+    // Чڣɵľ
+    vec2 uv = clamp(texCoord * iSourceScale, 0.5 * texel, iSourceScale - 0.5 * texel);
+    vec3 col = texture(iSource, uv).rgb;
+
+    if (iSharpness > 0.0)
+    {
+        vec3 blur = texture(iSource, min(uv + vec2(texel.x, 0.0), iSourceScale - 0.5 * texel)).rgb
+                  + texture(iSource, max(uv - vec2(texel.x, 0.0), 0.5 * texel)).rgb
+                  + texture(iSource, min(uv + vec2(0.0, texel.y), iSourceScale - 0.5 * texel)).rgb
+                  + texture(iSource, max(uv - vec2(0.0, texel.y), 0.5 * texel)).rgb;
+        col = max(col + iSharpness * (col - 0.25 * blur), vec3(0.0));
+    }
+
+    FragColor = vec4(col, 1.0);
+}
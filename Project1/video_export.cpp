@@ -0,0 +1,332 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifndef _WIN32
+#include <csignal>
+#endif
+#include "video_export.h"
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+#include "frame_capture.h"
+#include "parallel_render.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Ⱦ߳д֮߳н֡УдĻŻ spare ãܹ capacity + 1 ֡ڴ
+struct FrameQueue
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::pair<long long, std::vector<unsigned char>>> frames;
+    std::vector<std::vector<unsigned char>> spare;
+    size_t capacity = 8;
+    bool closed = false;    // ֡д߳ʧ
+
+    double pushWaitMs = 0.0;    // Ⱦ̵߳ȴпλϣ
+    double popWaitMs = 0.0;     // д̵߳ȴ֡Ⱦϣ
+};
+
+static std::vector<unsigned char> takeSpareBuffer(FrameQueue& queue, size_t size)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    std::vector<unsigned char> buffer;
+    if (!queue.spare.empty())
+    {
+        buffer = std::move(queue.spare.back());
+        queue.spare.pop_back();
+    }
+    buffer.resize(size);
+    return buffer;
+}
+
+// ʱȴѹرʱ false
+static bool pushFrame(FrameQueue& queue, long long frame, std::vector<unsigned char>&& rgb)
+{
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    if (queue.frames.size() >= queue.capacity && !queue.closed)
+    {
+        auto start = Clock::now();
+        queue.changed.wait(lock, [&]() { return queue.frames.size() < queue.capacity || queue.closed; });
+        queue.pushWaitMs += elapsedMs(start);
+    }
+    if (queue.closed)
+        return false;
+    queue.frames.emplace_back(frame, std::move(rgb));
+    queue.changed.notify_all();
+    return true;
+}
+
+// пʱȴѹرȡʱ false
+static bool popFrame(FrameQueue& queue, long long& frame, std::vector<unsigned char>& rgb)
+{
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    if (queue.frames.empty() && !queue.closed)
+    {
+        auto start = Clock::now();
+        queue.changed.wait(lock, [&]() { return !queue.frames.empty() || queue.closed; });
+        queue.popWaitMs += elapsedMs(start);
+    }
+    if (queue.frames.empty())
+        return false;
+    frame = queue.frames.front().first;
+    rgb = std::move(queue.frames.front().second);
+    queue.frames.pop_front();
+    queue.changed.notify_all();
+    return true;
+}
+
+static void closeFrameQueue(FrameQueue& queue)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.closed = true;
+    queue.changed.notify_all();
+}
+
+static void replaceAll(std::string& text, const std::string& key, const std::string& value)
+{
+    for (size_t pos = text.find(key); pos != std::string::npos; pos = text.find(key, pos + value.size()))
+        text.replace(pos, key.size(), value);
+}
+
+static std::string formatEncoderCommand(const RenderConfig& config)
+{
+    std::string command = config.exportEncoder.empty() ? DefaultVideoEncoder : config.exportEncoder;
+    replaceAll(command, "{width}", std::to_string(config.width));
+    replaceAll(command, "{height}", std::to_string(config.height));
+    replaceAll(command, "{fps}", std::to_string(config.exportFps));
+    replaceAll(command, "{output}", config.exportPath);
+    return command;
+}
+
+static FILE* openEncoder(const std::string& command)
+{
+#ifdef _WIN32
+    return _popen(command.c_str(), "wb");
+#else
+    // ǰ˳ʱ fwrite ش󣬶Ǳ SIGPIPE 
+    std::signal(SIGPIPE, SIG_IGN);
+    return popen(command.c_str(), "w");
+#endif
+}
+
+static int closeEncoder(FILE* pipe)
+{
+#ifdef _WIN32
+    return _pclose(pipe);
+#else
+    return pclose(pipe);
+#endif
+}
+
+// д̣߳֡˳ȡ֡¶дܵglReadPixels  -> Ƶ϶£
+static void writeFrames(FrameQueue& queue, FILE* pipe, int width, int height, bool& failed, double& writeMs)
+{
+    size_t rowBytes = static_cast<size_t>(width) * 3;
+    long long frame = 0;
+    std::vector<unsigned char> rgb;
+    while (popFrame(queue, frame, rgb))
+    {
+        auto start = Clock::now();
+        for (int y = height - 1; y >= 0 && !failed; y--)
+        {
+            if (std::fwrite(rgb.data() + rowBytes * y, 1, rowBytes, pipe) != rowBytes)
+                failed = true;
+        }
+        writeMs += elapsedMs(start);
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.spare.push_back(std::move(rgb));
+        }
+        if (failed)
+        {
+            std::cout << "дʧܣ " << frame << " ֡" << std::endl;
+            closeFrameQueue(queue);
+            return;
+        }
+    }
+}
+
+// ֡ iTimeۼӲƵʱ
+static float exportFrameTime(const RenderConfig& config, int frame)
+{
+    return static_cast<float>(config.startTime + static_cast<double>(frame) / config.exportFps);
+}
+
+// ģȾ߳ύƣ PBO غӡʼʧʱ false
+static bool exportSingleContext(const RenderConfig& config, const char* vertexSource, const char* fragmentSource,
+    int frames, FrameQueue& queue, bool& queueClosed)
+{
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return false;
+
+    BlackholeRenderer renderer;
+    if (!createBlackholeRenderer(renderer, config, vertexSource, fragmentSource))
+    {
+        destroyOffscreenContext(ctx);
+        return false;
+    }
+    RenderTarget target;
+    if (!createRenderTarget(target, config.width, config.height, GL_RGBA8))
+    {
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return false;
+    }
+
+    FrameCapture capture;
+    int ringSize = config.captureRing > 0 ? config.captureRing : 3;
+    if (!createFrameCapture(capture, config.width, config.height, ringSize,
+        [&](long long frame, const unsigned char* rgb, int width, int height)
+        {
+            size_t frameSize = static_cast<size_t>(width) * height * 3;
+            std::vector<unsigned char> buffer = takeSpareBuffer(queue, frameSize);
+            std::copy(rgb, rgb + frameSize, buffer.begin());
+            if (!pushFrame(queue, frame, std::move(buffer)))
+                queueClosed = true;
+        }))
+    {
+        deleteRenderTarget(target);
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return false;
+    }
+    std::cout << "GL_RENDERER" << glGetString(GL_RENDERER) << "PBO  " << ringSize << " " << std::endl;
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    double renderMs = 0.0;
+    int progressInterval = std::max(1, config.exportFps);
+    auto start = Clock::now();
+
+    for (int frame = 0; frame < frames && !queueClosed; frame++)
+    {
+        auto renderStart = Clock::now();
+        bindRenderTarget(target);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawBlackhole(renderer, exportFrameTime(config, frame), w, h, config.mouseX * w, config.mouseY * h);
+        renderMs += elapsedMs(renderStart);
+        captureFrame(capture, frame);
+
+        if ((frame + 1) % progressInterval == 0)
+            std::cout << "ѵ " << frame + 1 << " / " << frames << " ֡" << (frame + 1) / (elapsedMs(start) / 1000.0)
+                << " ֡/s" << std::endl;
+    }
+    if (!queueClosed)
+    {
+        flushFrameCapture(capture);
+        std::cout << "  ύȾ " << renderMs / frames << " ms/֡ " << capture.issueMs / frames
+            << " ms/֡ӳ " << capture.mapMs / frames << " ms/֡" << std::endl;
+    }
+
+    deleteFrameCapture(capture);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    deleteRenderTarget(target);
+    deleteBlackholeRenderer(renderer);
+    destroyOffscreenContext(ctx);
+    return true;
+}
+
+// ģ--contexts߳Ⱦ֡֡ź
+static bool exportParallel(const RenderConfig& config, const char* vertexSource, const char* fragmentSource,
+    int frames, FrameQueue& queue, bool& queueClosed)
+{
+    size_t frameSize = static_cast<size_t>(config.width) * config.height * 3;
+    int progressInterval = std::max(1, config.exportFps);
+    auto start = Clock::now();
+    ParallelRenderStats stats;
+    bool ok = renderFramesParallel(config, vertexSource, fragmentSource, config.contexts, 0, frames,
+        [&](int index) { return exportFrameTime(config, index); },
+        [&](int index, const unsigned char* rgb)
+        {
+            std::vector<unsigned char> buffer = takeSpareBuffer(queue, frameSize);
+            std::copy(rgb, rgb + frameSize, buffer.begin());
+            if (!pushFrame(queue, index, std::move(buffer)))
+            {
+                queueClosed = true;
+                return false;
+            }
+            if ((index + 1) % progressInterval == 0)
+                std::cout << "ѵ " << index + 1 << " / " << frames << " ֡" << (index + 1) / (elapsedMs(start) / 1000.0)
+                    << " ֡/s" << std::endl;
+            return true;
+        }, stats);
+    if (ok)
+        std::cout << "  " << config.contexts << " ģʼ " << stats.setupMs << " msȴȾ " << stats.consumerWaitMs
+            << " msȾ̵߳ȴ " << stats.aheadWaitMs << " ms" << std::endl;
+    return ok || queueClosed;
+}
+
+int runVideoExport(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    int frames = config.exportSeconds > 0.0f
+        ? std::max(1, static_cast<int>(std::lround(static_cast<double>(config.exportSeconds) * config.exportFps)))
+        : config.frames;
+    FrameQueue queue;
+    queue.capacity = static_cast<size_t>(config.exportQueue);
+    bool queueClosed = false;
+
+    std::string command = formatEncoderCommand(config);
+    std::cout << "Ƶ" << config.width << "x" << config.height << "" << config.exportFps << " ֡/s" << frames
+        << " ֡" << static_cast<double>(frames) / config.exportFps << " s " << config.exportQueue
+        << " ֡\n" << command << std::endl;
+
+    FILE* pipe = openEncoder(command);
+    // 
+    if (pipe == nullptr)
+    {
+        std::cout << "ʧܣ" << std::endl;
+        return -1;
+    }
+
+    bool writeFailed = false;
+    double writeMs = 0.0;
+    std::thread writer(writeFrames, std::ref(queue), pipe, config.width, config.height, std::ref(writeFailed), std::ref(writeMs));
+
+    auto start = Clock::now();
+    bool rendered = config.contexts > 1
+        ? exportParallel(config, vertexSource, fragmentSource, frames, queue, queueClosed)
+        : exportSingleContext(config, vertexSource, fragmentSource, frames, queue, queueClosed);
+    closeFrameQueue(queue);
+    writer.join();
+    int status = closeEncoder(pipe);
+    double seconds = elapsedMs(start) / 1000.0;
+
+    if (!rendered)
+    {
+        std::cout << "ƵжϣȾʧܣ" << std::endl;
+        return -1;
+    }
+    if (queueClosed || writeFailed)
+    {
+        std::cout << "Ƶжϣǰ˳" << std::endl;
+        return -1;
+    }
+    if (status != 0)
+    {
+        std::cout << "̷ش" << status << "" << std::endl;
+        return -1;
+    }
+    std::cout << frames << " ֡ʱ " << seconds << " s" << frames / seconds << " ֡/sʵʱ "
+        << frames / seconds / config.exportFps << " \n"
+        << "  д " << writeMs / frames << " ms/֡Ⱦȴ " << queue.pushWaitMs
+        << " msд̵߳ȴ֡ " << queue.popWaitMs << " ms" << std::endl;
+    return 0;
+}
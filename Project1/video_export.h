@@ -0,0 +1,13 @@
+#pragma once
+#include "render_config.h"
+
+// Ĭϱ{width} {height} {fps} {output} ʱ滻ԭʼ RGB ֡϶£ӱ׼
+const char* const DefaultVideoEncoder =
+    "ffmpeg -y -loglevel error -f rawvideo -pix_fmt rgb24 -s {width}x{height} -r {fps} -i - "
+    "-c:v libx264 -preset veryfast -pix_fmt yuv420p \"{output}\"";
+
+// Ƶ--export <file> EGL а̶ iTime = startTime + k / exportFps Ⱦ
+// ޹أ֡ PBO frame_capture.h첽غΪ exportQueue нУ
+// д߳ͨܵ͸̣exportEncoderGPU Ⱦغͱص
+// ʱȾ߳ڶϵȴڴռò exportQueue ֡
+int runVideoExport(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);
@@ -0,0 +1,191 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "view_atlas.h"
+#include "offscreen_context.h"
+#include "blackhole_renderer.h"
+#include "render_target.h"
+#include "image_write.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// ͼƣÿͼһ drawBlackholeӿΪͼеĶӦһ
+static void drawViewsSeparately(BlackholeRenderer& renderer, const std::vector<BlackholeView>& views, int columns,
+    int width, int height)
+{
+    float w = static_cast<float>(width);
+    float h = static_cast<float>(height);
+    for (size_t i = 0; i < views.size(); i++)
+    {
+        int column = static_cast<int>(i) % columns;
+        int row = static_cast<int>(i) / columns;
+        glViewport(column * width, row * height, width, height);
+        drawBlackhole(renderer, views[i].time, w, h, views[i].mouseX, views[i].mouseY);
+    }
+}
+
+int runViewAtlas(const RenderConfig& config, const char* vertexSource, const char* fragmentSource)
+{
+    // 
+    if (config.views < 1 || config.views > MaxViews)
+    {
+        std::cout << "ͼ 1 ~ " << MaxViews << " ֮䣡" << std::endl;
+        return -1;
+    }
+
+    OffscreenContext ctx;
+    if (!createOffscreenContext(ctx))
+        return -1;
+
+    std::cout << "GL_RENDERER" << glGetString(GL_RENDERER) << std::endl;
+
+    BlackholeRenderer renderer;
+    if (!createBlackholeRenderer(renderer, config, vertexSource, fragmentSource))
+    {
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    // 
+    if (!renderer.multiView)
+    {
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+
+    // ԱõĵͼȾͼͬѡֻǲע MULTI_VIEW
+    BlackholeRenderer single;
+    if (config.viewsCompare)
+    {
+        RenderConfig singleConfig = config;
+        singleConfig.views = 0;
+        if (!createBlackholeRenderer(single, singleConfig, vertexSource, fragmentSource))
+        {
+            deleteBlackholeRenderer(renderer);
+            destroyOffscreenContext(ctx);
+            return -1;
+        }
+    }
+
+    int columns, rows;
+    multiViewGrid(config.views, columns, rows);
+    int atlasWidth = columns * config.width;
+    int atlasHeight = rows * config.height;
+    RenderTarget target;
+    if (!createRenderTarget(target, atlasWidth, atlasHeight, GL_RGBA8))
+    {
+        if (config.viewsCompare)
+            deleteBlackholeRenderer(single);
+        deleteBlackholeRenderer(renderer);
+        destroyOffscreenContext(ctx);
+        return -1;
+    }
+    std::cout << config.views << " ͼͼ " << columns << " x " << rows << " " << atlasWidth << "x" << atlasHeight
+        << "" << std::endl;
+
+    size_t atlasSize = static_cast<size_t>(atlasWidth) * atlasHeight * 3;
+    std::vector<unsigned char> pixels(atlasSize);
+    std::vector<unsigned char> reference(config.viewsCompare ? atlasSize : 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    float w = static_cast<float>(config.width);
+    float h = static_cast<float>(config.height);
+    std::vector<BlackholeView> views(config.views);
+    double batchedMs = 0.0, separateMs = 0.0;
+    int maxDiff = 0;
+    size_t diffBytes = 0;
+    int result = 0;
+
+    // ͼͬһ iTimeֻͬ
+    auto setViews = [&](int index)
+    {
+        float time = config.startTime + index * config.timeStep;
+        for (int i = 0; i < config.views; i++)
+        {
+            views[i].time = time;
+            views[i].mouseX = config.mouseX * w;
+            views[i].mouseY = (config.mouseY + static_cast<float>(i) / config.views) * h;
+        }
+    };
+
+    // ʱԤȣֻƷʽһΣӳٱ롢䲻һ֡
+    setViews(config.startFrame);
+    bindRenderTarget(target);
+    drawBlackholeViews(renderer, views.data(), config.views, columns, w, h);
+    if (config.viewsCompare)
+        drawViewsSeparately(single, views, columns, config.width, config.height);
+    glReadPixels(0, 0, atlasWidth, atlasHeight, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    for (int frame = 0; frame < config.frames; frame++)
+    {
+        int index = config.startFrame + frame;
+        setViews(index);
+
+        // ʱأglReadPixels ȴ
+        bindRenderTarget(target);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        auto drawStart = Clock::now();
+        drawBlackholeViews(renderer, views.data(), config.views, columns, w, h);
+        glReadPixels(0, 0, atlasWidth, atlasHeight, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        double ms = elapsedMs(drawStart);
+        batchedMs += ms;
+        std::cout << " " << index << " ֡һλ " << ms << " msÿͼ " << ms / config.views << " ms";
+
+        if (config.viewsCompare)
+        {
+            bindRenderTarget(target);
+            glClear(GL_COLOR_BUFFER_BIT);
+            drawStart = Clock::now();
+            drawViewsSeparately(single, views, columns, config.width, config.height);
+            glReadPixels(0, 0, atlasWidth, atlasHeight, GL_RGB, GL_UNSIGNED_BYTE, reference.data());
+            double separate = elapsedMs(drawStart);
+            separateMs += separate;
+            for (size_t i = 0; i < atlasSize; i++)
+            {
+                int diff = std::abs(static_cast<int>(pixels[i]) - static_cast<int>(reference[i]));
+                if (diff > 0)
+                    diffBytes++;
+                maxDiff = std::max(maxDiff, diff);
+            }
+            std::cout << "ͼ " << separate << " ms";
+        }
+        std::cout << std::endl;
+
+        std::string path = formatFramePath(config.output, index);
+        if (!writeImagePPM(path, atlasWidth, atlasHeight, pixels.data(), true))
+        {
+            result = -1;
+            break;
+        }
+        std::cout << "д룺" << path << std::endl;
+    }
+
+    if (result == 0)
+    {
+        std::cout << "ƽÿͼһλ " << batchedMs / config.frames << " ms";
+        if (config.viewsCompare)
+        {
+            std::cout << "ͼ " << separateMs / config.frames << " ms" << separateMs / batchedMs
+                << " ͼƵĲ죺 " << maxDiff << "ֽͬ " << diffBytes << " / "
+                << atlasSize * config.frames;
+        }
+        std::cout << std::endl;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    deleteRenderTarget(target);
+    if (config.viewsCompare)
+        deleteBlackholeRenderer(single);
+    deleteBlackholeRenderer(renderer);
+    destroyOffscreenContext(ctx);
+    return result;
+}
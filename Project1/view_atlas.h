@@ -0,0 +1,7 @@
+#pragma once
+#include "render_config.h"
+
+// ͼͼ--views <n>ÿ֡ͬһ iTime  n ͼÿ width x heightųɽεͼ
+// һʵȾȫͼͼд outputͼ i ĸΪ mouseY + i / nƺڶһܣΪ mouseX
+// --views-compare ʱ n  drawBlackholeÿӿΪһȾͬһͼȽϺʱز
+int runViewAtlas(const RenderConfig& config, const char* vertexSource, const char* fragmentSource);